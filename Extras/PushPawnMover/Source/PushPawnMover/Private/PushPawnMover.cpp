@@ -0,0 +1,21 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PushPawnMover.h"
+
+#include "PushPawnMoverBackend.h"
+
+#define LOCTEXT_NAMESPACE "FPushPawnMoverModule"
+
+void FPushPawnMoverModule::StartupModule()
+{
+	UPushPawnMovementBackend::RegisterBackend(UPushPawnMovementBackend_Mover::StaticClass());
+}
+
+void FPushPawnMoverModule::ShutdownModule()
+{
+	UPushPawnMovementBackend::UnregisterBackend(UPushPawnMovementBackend_Mover::StaticClass());
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FPushPawnMoverModule, PushPawnMover)
@@ -0,0 +1,181 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PushPawnMoverBackend.h"
+
+#include "MoverComponent.h"
+#include "MoverSimulationTypes.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnMoverBackend)
+
+FLayeredMove_PushPawnForce::FLayeredMove_PushPawnForce()
+	: Velocity(FVector::ZeroVector)
+	, StrengthOverTime(nullptr)
+{
+	MixMode = EMoveMixMode::AdditiveVelocity;
+	Priority = 2;  // Low priority for pushing
+	FinishVelocitySettings.FinishVelocityMode = ELayeredMoveFinishVelocityMode::MaintainLastRootMotionVelocity;
+}
+
+bool FLayeredMove_PushPawnForce::GenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep,
+	const UMoverComponent* MoverComp, UMoverBlackboard* SimBlackboard, FProposedMove& OutProposedMove)
+{
+	if (Removed.IsValid() && Removed->load())
+	{
+		return false;
+	}
+
+	FVector VelocityToApply = Velocity;
+	if (StrengthOverTime && DurationMs > 0.f)
+	{
+		const float Alpha = FMath::Clamp((TimeStep.BaseSimTimeMs - StartSimTimeMs) / DurationMs, 0.f, 1.f);
+		VelocityToApply *= StrengthOverTime->GetFloatValue(Alpha);
+	}
+
+	OutProposedMove.MixMode = MixMode;
+	OutProposedMove.LinearVelocity = VelocityToApply;
+	return true;
+}
+
+FLayeredMoveBase* FLayeredMove_PushPawnForce::Clone() const
+{
+	return new FLayeredMove_PushPawnForce(*this);
+}
+
+void FLayeredMove_PushPawnForce::NetSerialize(FArchive& Ar)
+{
+	Super::NetSerialize(Ar);
+
+	SerializePackedVector<10, 16>(Velocity, Ar);
+	Ar << StrengthOverTime;
+}
+
+UScriptStruct* FLayeredMove_PushPawnForce::GetScriptStruct() const
+{
+	return FLayeredMove_PushPawnForce::StaticStruct();
+}
+
+FString FLayeredMove_PushPawnForce::ToSimpleString()
+{
+	return TEXT("PushPawnForce");
+}
+
+void FLayeredMove_PushPawnForce::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(Collector);
+
+	Collector.AddReferencedObject(StrengthOverTime);
+}
+
+UActorComponent* UPushPawnMovementBackend_Mover::FindMovementComponent(const AActor* Avatar) const
+{
+	return Avatar->FindComponentByClass<UMoverComponent>();
+}
+
+bool UPushPawnMovementBackend_Mover::CanPush(const UActorComponent* MovementComponent) const
+{
+	const UMoverComponent* MoverComp = Cast<UMoverComponent>(MovementComponent);
+	return MoverComp && !MoverComp->GetMovementModeName().IsNone();
+}
+
+int32 UPushPawnMovementBackend_Mover::ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const
+{
+	UMoverComponent* MoverComp = Cast<UMoverComponent>(MovementComponent);
+	if (!MoverComp)
+	{
+		return INDEX_NONE;
+	}
+
+	PruneExpiredPushes(MoverComp);
+
+	FPushPawnMoverPush Push;
+	Push.ID = LastPushID = LastPushID == MAX_int32 ? 0 : LastPushID + 1;
+	Push.EndTime = Force.Duration >= 0.f ? MoverComp->GetWorld()->GetTimeSeconds() + Force.Duration : -1.0;
+	Push.Removed = MakeShared<std::atomic<bool>>(false);
+	ActivePushes.FindOrAdd(MoverComp).Add(Push);
+
+	// Simulated proxies receive the push through the server's sync state, it is only tracked
+	if (MoverComp->GetOwnerRole() == ROLE_SimulatedProxy)
+	{
+		return Push.ID;
+	}
+
+	const TSharedPtr<FLayeredMove_PushPawnForce> PushMove = MakeShared<FLayeredMove_PushPawnForce>();
+	PushMove->MixMode = Force.bIsAdditive ? EMoveMixMode::AdditiveVelocity : EMoveMixMode::OverrideVelocity;
+	PushMove->DurationMs = Force.Duration * 1000.f;
+	PushMove->StrengthOverTime = Force.StrengthOverTime;
+	PushMove->Removed = Push.Removed;
+
+	// Leave the vertical velocity to the movement mode's gravity
+	PushMove->Velocity = Force.bEnableGravity ? FVector::VectorPlaneProject(Force.Force, MoverComp->GetUpDirection()) : Force.Force;
+
+	MoverComp->QueueLayeredMove(PushMove);
+	return Push.ID;
+}
+
+void UPushPawnMovementBackend_Mover::RemovePush(UActorComponent* MovementComponent, int32 PushID) const
+{
+	TArray<FPushPawnMoverPush, TInlineAllocator<2>>* Pushes = ActivePushes.Find(MovementComponent);
+	if (!Pushes || PushID == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 PushIndex = Pushes->IndexOfByPredicate([PushID](const FPushPawnMoverPush& Push) { return Push.ID == PushID; });
+	if (PushIndex != INDEX_NONE)
+	{
+		(*Pushes)[PushIndex].Removed->store(true);
+		Pushes->RemoveAtSwap(PushIndex);
+		if (Pushes->Num() == 0)
+		{
+			ActivePushes.Remove(MovementComponent);
+		}
+	}
+}
+
+bool UPushPawnMovementBackend_Mover::IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const
+{
+	const FPushPawnMoverPush* Push = FindPush(MovementComponent, PushID);
+	if (!Push || Push->Removed->load())
+	{
+		return false;
+	}
+	return Push->EndTime < 0.0 || MovementComponent->GetWorld()->GetTimeSeconds() < Push->EndTime;
+}
+
+const FPushPawnMoverPush* UPushPawnMovementBackend_Mover::FindPush(const UActorComponent* MovementComponent,
+	int32 PushID) const
+{
+	const TArray<FPushPawnMoverPush, TInlineAllocator<2>>* Pushes = ActivePushes.Find(MovementComponent);
+	if (!Pushes || PushID == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	return Pushes->FindByPredicate([PushID](const FPushPawnMoverPush& Push) { return Push.ID == PushID; });
+}
+
+void UPushPawnMovementBackend_Mover::PruneExpiredPushes(const UActorComponent* MovementComponent) const
+{
+	if (TArray<FPushPawnMoverPush, TInlineAllocator<2>>* Pushes = ActivePushes.Find(MovementComponent))
+	{
+		const double Now = MovementComponent->GetWorld()->GetTimeSeconds();
+		Pushes->RemoveAllSwap([Now](const FPushPawnMoverPush& Push)
+		{
+			return Push.EndTime >= 0.0 && Now >= Push.EndTime;
+		});
+	}
+
+	if (ActivePushes.Num() >= 64)
+	{
+		for (auto It = ActivePushes.CreateIterator(); It; ++It)
+		{
+			if (It.Value().Num() == 0 || !It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
@@ -0,0 +1,106 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayeredMove.h"
+#include "PushPawnMovementBackend.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+#include "PushPawnMoverBackend.generated.h"
+
+class UCurveFloat;
+
+/**
+ * A push applied as a layered move, the Mover equivalent of FRootMotionSource_ConstantForce
+ * Layered moves are part of Mover's predicted sync state, so the push is rolled back and resimulated along with the
+ * rest of the movement instead of being corrected after the fact
+ */
+USTRUCT(BlueprintType)
+struct PUSHPAWNMOVER_API FLayeredMove_PushPawnForce : public FLayeredMoveBase
+{
+	GENERATED_BODY()
+
+	FLayeredMove_PushPawnForce();
+	virtual ~FLayeredMove_PushPawnForce() override {}
+
+	/** World space velocity to add, direction multiplied by strength */
+	UPROPERTY(BlueprintReadWrite, Category=PushPawn)
+	FVector Velocity;
+
+	/** Optional, scales Velocity over the normalized duration */
+	UPROPERTY(BlueprintReadWrite, Category=PushPawn)
+	TObjectPtr<UCurveFloat> StrengthOverTime;
+
+	/**
+	 * Set by UPushPawnMovementBackend_Mover::RemovePush(), the move stops contributing until its duration runs out
+	 * Shared by every copy of the move in the simulation's history, not replicated
+	 */
+	TSharedPtr<std::atomic<bool>> Removed;
+
+	virtual bool GenerateMove(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep,
+		const UMoverComponent* MoverComp, UMoverBlackboard* SimBlackboard, FProposedMove& OutProposedMove) override;
+
+	virtual FLayeredMoveBase* Clone() const override;
+	virtual void NetSerialize(FArchive& Ar) override;
+	virtual UScriptStruct* GetScriptStruct() const override;
+	virtual FString ToSimpleString() override;
+	virtual void AddReferencedObjects(class FReferenceCollector& Collector) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLayeredMove_PushPawnForce> : public TStructOpsTypeTraitsBase2<FLayeredMove_PushPawnForce>
+{
+	enum
+	{
+		WithCopy = true
+	};
+};
+
+/** A push queued by UPushPawnMovementBackend_Mover, tracked until its duration has elapsed */
+struct FPushPawnMoverPush
+{
+	int32 ID = INDEX_NONE;
+
+	/** World time the push ends at, negative if it runs until removed */
+	double EndTime = -1.0;
+
+	/** Shared with the queued move, see FLayeredMove_PushPawnForce::Removed */
+	TSharedPtr<std::atomic<bool>> Removed;
+};
+
+/**
+ * Pushes UMoverComponent by queueing FLayeredMove_PushPawnForce
+ * Registered by the PushPawnMover module, takes precedence over UPushPawnMovementBackend_Character
+ *
+ * Pushes are still triggered through the push abilities, but once queued they are owned by the Mover simulation
+ * The scan abilities skip their net syncs for Mover pawns, see UPushPawnMovementBackend::IsPredictedByMovement()
+ *
+ * Mover can't query or cancel layered moves once queued, so each push is tracked here by ID for its duration
+ * Removing a push stops it contributing velocity, the layered move itself stays queued until its duration runs out
+ */
+UCLASS()
+class PUSHPAWNMOVER_API UPushPawnMovementBackend_Mover : public UPushPawnMovementBackend
+{
+	GENERATED_BODY()
+
+public:
+	virtual UActorComponent* FindMovementComponent(const AActor* Avatar) const override;
+	virtual bool CanPush(const UActorComponent* MovementComponent) const override;
+	virtual int32 ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const override;
+	virtual void RemovePush(UActorComponent* MovementComponent, int32 PushID) const override;
+	virtual bool IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const override;
+	virtual bool IsPredictedByMovement() const override { return true; }
+
+private:
+	/** @return The push if it is still tracked */
+	const FPushPawnMoverPush* FindPush(const UActorComponent* MovementComponent, int32 PushID) const;
+
+	/** Drop the component's pushes that have run their duration, and components that have since been destroyed */
+	void PruneExpiredPushes(const UActorComponent* MovementComponent) const;
+
+	/** Pushes that may still be running, per mover component, the backend is only used through its class default object */
+	mutable TMap<FObjectKey, TArray<FPushPawnMoverPush, TInlineAllocator<2>>> ActivePushes;
+
+	mutable int32 LastPushID = INDEX_NONE;
+};
@@ -15,6 +15,45 @@
 
 #define LOCTEXT_NAMESPACE "PushPawnAbility"
 
+namespace PushPawnPrevalidation
+{
+	/** The spec of the innermost open scope, game thread only */
+	static FObjectKey ScopeAbilitySystem;
+	static FGameplayAbilitySpecHandle ScopeHandle;
+}
+
+FPushPawnPrevalidatedScope::FPushPawnPrevalidatedScope(const UAbilitySystemComponent* AbilitySystem,
+	FGameplayAbilitySpecHandle Handle, bool bPrevalidated)
+	: PreviousAbilitySystem(PushPawnPrevalidation::ScopeAbilitySystem)
+	, PreviousHandle(PushPawnPrevalidation::ScopeHandle)
+{
+	check(IsInGameThread());
+	PushPawnPrevalidation::ScopeAbilitySystem = bPrevalidated ? FObjectKey(AbilitySystem) : FObjectKey();
+	PushPawnPrevalidation::ScopeHandle = bPrevalidated ? Handle : FGameplayAbilitySpecHandle();
+}
+
+FPushPawnPrevalidatedScope::~FPushPawnPrevalidatedScope()
+{
+	PushPawnPrevalidation::ScopeAbilitySystem = PreviousAbilitySystem;
+	PushPawnPrevalidation::ScopeHandle = PreviousHandle;
+}
+
+bool FPushPawnPrevalidatedScope::ConsumePrevalidated(const UAbilitySystemComponent* AbilitySystem,
+	FGameplayAbilitySpecHandle Handle)
+{
+	using namespace PushPawnPrevalidation;
+
+	if (!Handle.IsValid() || ScopeHandle != Handle || ScopeAbilitySystem != FObjectKey(AbilitySystem) || !IsInGameThread())
+	{
+		return false;
+	}
+
+	// Anything else activated within this scope has to validate itself
+	ScopeAbilitySystem = FObjectKey();
+	ScopeHandle = FGameplayAbilitySpecHandle();
+	return true;
+}
+
 UPushPawn_Ability::UPushPawn_Ability(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -29,7 +68,7 @@ bool UPushPawn_Ability::CanActivateAbility(const FGameplayAbilitySpecHandle Hand
 	const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawn_Ability::CanActivateAbility);
-	
+
 	// A valid AvatarActor is required.
 	const AActor* const AvatarActor = ActorInfo ? ActorInfo->AvatarActor.Get() : nullptr;
 	if (AvatarActor == nullptr)
@@ -50,11 +89,15 @@ bool UPushPawn_Ability::CanActivateAbility(const FGameplayAbilitySpecHandle Hand
 		return false;
 	}
 
-	const FGameplayAbilitySpec* Spec = AbilitySystemComponent->FindAbilitySpecFromHandle(Handle);
-	if (!Spec)
+	// The spec was already found moments before the push was triggered, don't search for it again
+	if (!FPushPawnPrevalidatedScope::ConsumePrevalidated(AbilitySystemComponent, Handle))
 	{
-		ABILITY_LOG(Warning, TEXT("CanActivateAbility %s failed, called with invalid Handle"), *GetName());
-		return false;
+		const FGameplayAbilitySpec* Spec = AbilitySystemComponent->FindAbilitySpecFromHandle(Handle);
+		if (!Spec)
+		{
+			ABILITY_LOG(Warning, TEXT("CanActivateAbility %s failed, called with invalid Handle"), *GetName());
+			return false;
+		}
 	}
 
 	if (!bAllowBlueprintImplementation)
@@ -69,7 +112,7 @@ void UPushPawn_Ability::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
 	const FGameplayEventData* TriggerEventData)
 {
-	ActivatePushPawnAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+	const bool bActivated = ActivatePushPawnAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 	
 	if (bAllowBlueprintImplementation)
 	{
@@ -88,6 +131,11 @@ void UPushPawn_Ability::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 		}
 #endif
 		CommitAbility(Handle, ActorInfo, ActivationInfo);
+
+		if (bActivated)
+		{
+			OnPushPawnAbilityCommitted(Handle, ActorInfo, ActivationInfo);
+		}
 	}
 }
 
@@ -3,10 +3,13 @@
 
 #include "Abilities/PushPawn_Action.h"
 
-#include "GameFramework/Character.h"
-#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Pawn.h"
 #include "Tasks/AbilityTask_PushPawnForce.h"
 #include "PushStatics.h"
+#include "PushPawnSubsystem.h"
+#include "PushPawnProfile.h"
+#include "PushPawnStats.h"
+#include "PushPawnMovementBackend.h"
 
 #include "AbilitySystemLog.h"
 #include "DrawDebugHelpers.h"
@@ -26,16 +29,50 @@ namespace FPushPawnCVars
 #endif
 }
 
+const FPushPawnActionParams& UPushPawn_Action::GetPushParams() const
+{
+	return Profile ? Profile->ActionParams : PushParams;
+}
+
+const FPushPawnStrengthEvaluator& UPushPawn_Action::GetStrengthEvaluator() const
+{
+	return Profile ? Profile->StrengthEvaluator : StrengthEvaluator;
+}
+
+void UPushPawn_Action::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	StrengthEvaluator.Bind(PushParams);
+}
+
+void UPushPawn_Action::PostLoad()
+{
+	Super::PostLoad();
+
+	StrengthEvaluator.Bind(PushParams);
+}
+
+#if WITH_EDITOR
+void UPushPawn_Action::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	StrengthEvaluator.Bind(PushParams);
+}
+#endif
+
 bool UPushPawn_Action::ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Handle,
 	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
 	const FGameplayEventData* TriggerEventData)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawn_Action::ActivatePushPawnAbility);
+	LLM_SCOPE_BYTAG(PushPawn);
 
 	const FGameplayEventData& EventData = *TriggerEventData;
 
 	// Gather Pusher and Pushee
-	UPushStatics::GetPushPawnsFromEventDataChecked<ACharacter, ACharacter>(EventData, Pushee, Pusher);
+	UPushStatics::GetPushPawnsFromEventDataChecked<APawn, APawn>(EventData, Pushee, Pusher);
 
 	// Check for null -- we can be destroyed during ability activation and crash!
 	if (!IsValid(Pushee) || !IsValid(Pusher))
@@ -45,21 +82,32 @@ bool UPushPawn_Action::ActivatePushPawnAbility(const FGameplayAbilitySpecHandle
 		return false;
 	}
 
-	// Check for valid movement component and mode
-	const UCharacterMovementComponent* MovementComponent = Pushee->GetCharacterMovement();
-	if (!MovementComponent || MovementComponent->MovementMode == MOVE_None)
+	// Check for a movement component we know how to push, in a mode that can be pushed
+	UActorComponent* MovementComponent = nullptr;
+	const UPushPawnMovementBackend* MovementBackend = UPushPawnMovementBackend::FindBackend(Pushee, MovementComponent);
+	if (!MovementBackend || !MovementBackend->CanPush(MovementComponent))
 	{
 		CancelAbility(Handle, ActorInfo, ActivationInfo, false);
 		return false;
 	}
 	
 	// Gather Push Data
-	UPushStatics::GetPushDataFromEventData(EventData, PushParams.bDistanceCheck2D, PushDirection,
+	const FPushPawnActionParams& Params = GetPushParams();
+	UPushStatics::GetPushDataFromEventData(EventData, Params.bDistanceCheck2D, PushDirection,
 		DistanceBetween, StrengthScalar, bOverrideStrength);
+
+	// Replicate the cancellation so the client's prediction is undone
+	if (!VerifyClientPush(ActorInfo, ActivationInfo, Pushee, Pusher, PushDirection, DistanceBetween, Params.bDistanceCheck2D))
+	{
+		CancelAbility(Handle, ActorInfo, ActivationInfo, true);
+		return false;
+	}
 	
 	// Push Strength
-	NormalizedDistance = UPushStatics::GetNormalizedPushDistance(Pushee, Pusher, DistanceBetween);
-	Strength = UPushStatics::CalculatePushStrength(Pushee, bOverrideStrength, StrengthScalar, NormalizedDistance, PushParams);
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(Pushee);
+	NormalizedDistance = Subsystem ? Subsystem->GetPairCache().GetNormalizedDistance(Pushee, Pusher, DistanceBetween) :
+		UPushStatics::GetNormalizedPushDistance(Pushee, Pusher, DistanceBetween);
+	Strength = GetStrengthEvaluator().Calculate(Pushee, bOverrideStrength, StrengthScalar, NormalizedDistance);
 
 #if UE_ENABLE_DEBUG_DRAWING
 	if (FPushPawnCVars::PushPawnActionDebugDraw > 0)  // Use WantsPushPawnActionDebugDraw() in derived classes
@@ -78,7 +126,7 @@ bool UPushPawn_Action::ActivatePushPawnAbility(const FGameplayAbilitySpecHandle
 	static constexpr bool bIsAdditive = true;
 	static constexpr bool bEnableGravity = true;
 	UAbilityTask_PushPawnForce* PushTask = UAbilityTask_PushPawnForce::ApplyPushPawnForce(
-		this, PushDirection, Strength, PushParams.Duration, bIsAdditive, bEnableGravity);
+		this, PushDirection, Strength, Params.Duration, bIsAdditive, bEnableGravity);
 
 	// Bind EndAbility to OnFinish
 	PushTask->OnFinish.AddDynamic(this, &UPushPawn_Action::OnPushTaskFinished);
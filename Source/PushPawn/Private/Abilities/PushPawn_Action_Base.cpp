@@ -5,6 +5,7 @@
 
 #include "IPush.h"
 #include "PushStatics.h"
+#include "PushPawnSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawn_Action_Base)
 
@@ -30,6 +31,27 @@ bool UPushPawn_Action_Base::CanActivatePushPawnAbility(const AActor* AvatarActor
 	return false;
 }
 
+bool UPushPawn_Action_Base::VerifyClientPush(const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo& ActivationInfo, const AActor* Pushee, const AActor* Pusher,
+	const FVector& Direction, float Distance, bool bDistance2D)
+{
+	// Only activations predicted by a remote client carry a valid prediction key on authority
+	if (!ActorInfo->IsNetAuthority() || ActorInfo->IsLocallyControlled() ||
+		!ActivationInfo.GetActivationPredictionKey().IsValidKey())
+	{
+		return true;
+	}
+
+	// The pushee comes from the event data the client sent, it can only predict pushes against its own pawn
+	if (Pushee != ActorInfo->AvatarActor.Get())
+	{
+		return false;
+	}
+
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(Pushee);
+	return !Subsystem || Subsystem->VerifyClientPush(Pushee, Pusher, Direction, Distance, bDistance2D);
+}
+
 bool UPushPawn_Action_Base::WantsPushPawnActionDebugDraw()
 {
 #if UE_ENABLE_DEBUG_DRAWING
@@ -0,0 +1,207 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "Abilities/PushPawn_Action_NonInstanced.h"
+
+#include "GameFramework/Pawn.h"
+#include "PushStatics.h"
+#include "PushPawnSubsystem.h"
+#include "PushPawnProfile.h"
+#include "PushPawnMovementBackend.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AbilitySystemLog.h"
+#include "DrawDebugHelpers.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawn_Action_NonInstanced)
+
+bool FPushPawnActionState::IsActive() const
+{
+	const UPushPawnMovementBackend* Backend = MovementBackend.Get();
+	return Backend && Backend->IsPushActive(MovementComponent.Get(), PushID);
+}
+
+UPushPawn_Action_NonInstanced::UPushPawn_Action_NonInstanced(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::NonInstanced;
+	bRetriggerInstancedAbility = false;
+}
+
+const FPushPawnActionParams& UPushPawn_Action_NonInstanced::GetPushParams() const
+{
+	return Profile ? Profile->ActionParams : PushParams;
+}
+
+const FPushPawnStrengthEvaluator& UPushPawn_Action_NonInstanced::GetStrengthEvaluator() const
+{
+	return Profile ? Profile->StrengthEvaluator : StrengthEvaluator;
+}
+
+void UPushPawn_Action_NonInstanced::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	StrengthEvaluator.Bind(PushParams);
+}
+
+void UPushPawn_Action_NonInstanced::PostLoad()
+{
+	Super::PostLoad();
+
+	StrengthEvaluator.Bind(PushParams);
+}
+
+#if WITH_EDITOR
+void UPushPawn_Action_NonInstanced::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	StrengthEvaluator.Bind(PushParams);
+}
+#endif
+
+const FPushPawnActionState* UPushPawn_Action_NonInstanced::GetActiveState(const UAbilitySystemComponent* AbilitySystem,
+	FGameplayAbilitySpecHandle Handle) const
+{
+	const FPushPawnActionState* State = ActiveStates.Find(FPushPawnActionStateKey(AbilitySystem, Handle));
+	return State && State->IsActive() ? State : nullptr;
+}
+
+bool UPushPawn_Action_NonInstanced::ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
+	const FGameplayEventData* TriggerEventData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawn_Action_NonInstanced::ActivatePushPawnAbility);
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	const FGameplayEventData& EventData = *TriggerEventData;
+
+	// Gather Pusher and Pushee
+	TObjectPtr<const APawn> Pushee = nullptr;
+	TObjectPtr<const APawn> Pusher = nullptr;
+	UPushStatics::GetPushPawnsFromEventDataChecked<APawn, APawn>(EventData, Pushee, Pusher);
+
+	// Check for null -- we can be destroyed during ability activation and crash!
+	if (!IsValid(Pushee) || !IsValid(Pusher))
+	{
+		ABILITY_LOG(Error, TEXT("PushPawn_Action_NonInstanced: Pushee or Pusher is null!"));
+		CancelAbility(Handle, ActorInfo, ActivationInfo, false);
+		return false;
+	}
+
+	// Check for valid movement component and mode, the force is applied to our own movement component
+	UActorComponent* MovementComponent = nullptr;
+	const UPushPawnMovementBackend* MovementBackend = UPushPawnMovementBackend::FindBackend(ActorInfo->AvatarActor.Get(), MovementComponent);
+	if (!MovementBackend || !MovementBackend->CanPush(MovementComponent))
+	{
+		CancelAbility(Handle, ActorInfo, ActivationInfo, false);
+		return false;
+	}
+
+	// Gather Push Data
+	const FPushPawnActionParams& Params = GetPushParams();
+	FVector PushDirection;
+	float DistanceBetween;
+	float StrengthScalar;
+	bool bOverrideStrength;
+	UPushStatics::GetPushDataFromEventData(EventData, Params.bDistanceCheck2D, PushDirection,
+		DistanceBetween, StrengthScalar, bOverrideStrength);
+
+	// Replicate the cancellation so the client's prediction is undone
+	if (!VerifyClientPush(ActorInfo, ActivationInfo, Pushee, Pusher, PushDirection, DistanceBetween, Params.bDistanceCheck2D))
+	{
+		CancelAbility(Handle, ActorInfo, ActivationInfo, true);
+		return false;
+	}
+
+	// Push Strength
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(Pushee);
+	const float NormalizedDistance = Subsystem ?
+		Subsystem->GetPairCache().GetNormalizedDistance(Pushee, Pusher, DistanceBetween) :
+		UPushStatics::GetNormalizedPushDistance(Pushee, Pusher, DistanceBetween);
+	const float Strength = GetStrengthEvaluator().Calculate(Pushee, bOverrideStrength, StrengthScalar, NormalizedDistance);
+
+#if UE_ENABLE_DEBUG_DRAWING
+	if (WantsPushPawnActionDebugDraw())
+	{
+		DrawDebugDirectionalArrow(Pushee->GetWorld(), Pushee->GetActorLocation(),
+			Pushee->GetActorLocation() + PushDirection * 100.f, 40.f, FColor::Magenta,
+			false, 1.0f);
+	}
+#endif
+
+	// Replace the previous push, as retriggering an instanced action would
+	const UAbilitySystemComponent* AbilitySystem = ActorInfo->AbilitySystemComponent.Get();
+	RemoveActiveState(AbilitySystem, Handle);
+	PruneActiveStates();
+
+	float Duration = Params.Duration;
+	UAbilitySystemGlobals::NonShipping_ApplyGlobalAbilityScaler_Duration(Duration);
+
+	// Apply Push Force, matches UAbilityTask_PushPawnForce
+	FPushPawnForce Force;
+	Force.Force = PushDirection.GetSafeNormal() * Strength;
+	Force.Duration = Duration;
+
+	const int32 PushID = MovementBackend->ApplyPush(MovementComponent, Force);
+	if (PushID == INDEX_NONE)
+	{
+		ABILITY_LOG(Warning, TEXT("PushPawn_Action_NonInstanced failed to apply push force"));
+		CancelAbility(Handle, ActorInfo, ActivationInfo, false);
+		return false;
+	}
+
+	ActiveStates.Add(FPushPawnActionStateKey(AbilitySystem, Handle), { MovementComponent, MovementBackend, PushID });
+	return true;
+}
+
+void UPushPawn_Action_NonInstanced::OnPushPawnAbilityCommitted(const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo)
+{
+	// Nothing left to wait on, the push finishes by itself
+	static constexpr bool bReplicateEndAbility = false;
+	static constexpr bool bWasCancelled = false;
+	EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+void UPushPawn_Action_NonInstanced::OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilitySpec& Spec)
+{
+	RemoveActiveState(ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr, Spec.Handle);
+
+	Super::OnRemoveAbility(ActorInfo, Spec);
+}
+
+void UPushPawn_Action_NonInstanced::RemoveActiveState(const UAbilitySystemComponent* AbilitySystem,
+	FGameplayAbilitySpecHandle Handle)
+{
+	FPushPawnActionState State;
+	if (ActiveStates.RemoveAndCopyValue(FPushPawnActionStateKey(AbilitySystem, Handle), State))
+	{
+		const UPushPawnMovementBackend* Backend = State.MovementBackend.Get();
+		UActorComponent* MovementComponent = State.MovementComponent.Get();
+		if (Backend && MovementComponent)
+		{
+			Backend->RemovePush(MovementComponent, State.PushID);
+		}
+	}
+}
+
+void UPushPawn_Action_NonInstanced::PruneActiveStates()
+{
+	// Expired states are harmless, only prune once there are enough of them to matter
+	if (ActiveStates.Num() < 32)
+	{
+		return;
+	}
+
+	for (auto It = ActiveStates.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsActive())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
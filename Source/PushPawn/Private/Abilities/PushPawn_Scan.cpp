@@ -5,6 +5,7 @@
 
 #include "Tasks/AbilityTask_PushPawnScan.h"
 #include "PushQuery.h"
+#include "PushPawnProfile.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawn_Scan)
 
@@ -13,6 +14,7 @@ bool UPushPawn_Scan::ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Ha
 	const FGameplayEventData* TriggerEventData)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawn_Scan::ActivatePushPawnAbility);
+	LLM_SCOPE_BYTAG(PushPawn);
 
 	if (Super::ActivatePushPawnAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData))
 	{
@@ -20,9 +22,10 @@ bool UPushPawn_Scan::ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Ha
 		const FPushQuery Query { GetAvatarActorFromActorInfo() };
 		const FGameplayAbilityTargetingLocationInfo StartLocation = MakeTargetLocationInfoFromOwnerActor();
 
-		// Create the task
-		UAbilityTask_PushPawnScan* Task = UAbilityTask_PushPawnScan::PushPawnScan(
-			this, Query, StartLocation, ScanParams);
+		// Create the task, a shared profile is referenced rather than copied
+		UAbilityTask_PushPawnScan* Task = Profile ?
+			UAbilityTask_PushPawnScan::PushPawnScanWithProfile(this, Query, StartLocation, Profile) :
+			UAbilityTask_PushPawnScan::PushPawnScan(this, Query, StartLocation, ScanParams);
 
 		// Bind the event
 		Task->PushObjectsChanged.AddDynamic(this, &ThisClass::OnPushObjectsChanged);
@@ -9,12 +9,37 @@
 #include "Tasks/AbilityTask_PushPawnScan.h"
 #include "IPush.h"
 #include "PushStatics.h"
+#include "PushPawnSubsystem.h"
+#include "PushPawnProfile.h"
+#include "PushPawnBenchmark.h"
+#include "PushPawnMovementBackend.h"
 #include "PushPawnTags.h"
 
 #include "Engine/World.h"
+#include "TimerManager.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawn_Scan_Base)
 
+namespace PushPawnScan
+{
+	/** Overwrite the pooled target data if we're the only one holding it, otherwise allocate a new one */
+	template<typename TargetDataT, typename... ArgTypes>
+	static TSharedPtr<TargetDataT> AcquirePooled(TSharedPtr<TargetDataT>& Pooled, ArgTypes&&... Args)
+	{
+		if (Pooled.IsValid() && Pooled.IsUnique())
+		{
+			*Pooled = TargetDataT(Forward<ArgTypes>(Args)...);
+		}
+		else
+		{
+			Pooled = MakeShared<TargetDataT>(Forward<ArgTypes>(Args)...);
+		}
+		return Pooled;
+	}
+}
+
 UPushPawn_Scan_Base::UPushPawn_Scan_Base(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -34,8 +59,26 @@ void UPushPawn_Scan_Base::OnGameplayTaskInitialized(UGameplayTask& Task)
 
 void UPushPawn_Scan_Base::OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
 {
+	LLM_SCOPE_BYTAG(PushPawn);
+
 	Super::OnAvatarSet(ActorInfo, Spec);
 
+	// Grant push abilities up front, instead of when a crowd first converges
+	if (ActorInfo->IsNetAuthority())
+	{
+		if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(ActorInfo->AvatarActor.Get()))
+		{
+			Subsystem->PreGrantPushAbilities(ActorInfo->AbilitySystemComponent.Get(), PushAbilitiesToPreGrant);
+		}
+		else
+		{
+			for (const TSubclassOf<UGameplayAbility>& Ability : PushAbilitiesToPreGrant)
+			{
+				UPushPawnSubsystem::GrantPushAbility(ActorInfo->AbilitySystemComponent.Get(), Ability);
+			}
+		}
+	}
+
 	// If we're auto-activating, try to activate the ability
 	if (bAutoActivateOnGrantAbility)
 	{
@@ -62,17 +105,36 @@ bool UPushPawn_Scan_Base::ActivatePushPawnAbility(const FGameplayAbilitySpecHand
 
 	LastNetSyncTime = GetWorld()->GetTimeSeconds();
 
+	// Movement simulations that own their push state don't need us to sync them
+	UActorComponent* MovementComponent = nullptr;
+	const UPushPawnMovementBackend* MovementBackend = UPushPawnMovementBackend::FindBackend(AvatarActor, MovementComponent);
+	bPushesPredictedByMovement = MovementBackend && MovementBackend->IsPredictedByMovement();
+
 	return true;
 }
 
+void UPushPawn_Scan_Base::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(SuppressedPushTimerHandle);
+	}
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
 void UPushPawn_Scan_Base::UpdatePushes(const TArray<FPushOption>& PushOptions)
 {
+	LLM_SCOPE_BYTAG(PushPawn);
+
 	CurrentOptions = PushOptions;
 }
 
 void UPushPawn_Scan_Base::TriggerPush()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawn_Scan_Base::TriggerPush);
+	LLM_SCOPE_BYTAG(PushPawn);
 
 	// If we have no options, we can't do anything
 	if (CurrentOptions.Num() == 0)
@@ -87,30 +149,75 @@ void UPushPawn_Scan_Base::TriggerPush()
 	AActor* PusheeInstigatorActor = GetAvatarActorFromActorInfo();
 	AActor* PusherTargetActor = UPushStatics::GetActorFromPushTarget(PushOption.PusherTarget);
 
+	// The same pusher can't push us again until the previous push has had time to separate us
+	const float MinPushInterval = GetScanParams().MinPushInterval;
+	if (MinPushInterval > 0.f && PusherTargetActor)
+	{
+		const float* PusherLastPushTime = LastPushTimeByPusher.Find(PusherTargetActor);
+		const float TimeSincePush = PusherLastPushTime ? GetWorld()->TimeSince(*PusherLastPushTime) : MinPushInterval;
+		if (TimeSincePush < MinPushInterval)
+		{
+			INC_DWORD_STAT(STAT_PushPawn_PushesSuppressed);
+
+			// Options only broadcast when they change, a pusher still in contact would otherwise never push us again
+			GetWorld()->GetTimerManager().SetTimer(SuppressedPushTimerHandle, this, &ThisClass::TriggerPush,
+				MinPushInterval - TimeSincePush, false);
+			return;
+		}
+	}
+
 	// The ability instigator that is being pushed
 	const IPusheeInstigator* PusheeInstigator = UPushStatics::GetPusheeInstigator(PusheeInstigatorActor);
 	
 	// The ability target that does the pushing
 	const IPusherTarget* PusherTarget = UPushStatics::GetPusherTarget(PusherTargetActor);
 
-	// Check if the pushee can be pushed by the pusher
-	const bool bCanBePushed = PusheeInstigator && PusheeInstigator->CanBePushedBy(PusherTargetActor);
+	// The rule set is a single lookup, check it before calling through the interfaces
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this);
+	if (Subsystem && !Subsystem->PassesPushRules(PusherTargetActor, PusheeInstigatorActor))
+	{
+		return;
+	}
 
-	// Check if the pusher can push the pushee
-	const bool bCanPush = PusherTarget && PusherTarget->CanPushPawn(PusheeInstigatorActor);
+	// The other pawn of this pair may have already computed the results we need this frame
+	FPushPawnPairCache* PairCache = Subsystem ? &Subsystem->GetPairCache() : nullptr;
+
+	// Check if the pushee can be pushed by the pusher, and the pusher can push the pushee
+	bool bCanPush;
+	if (PairCache)
+	{
+		bCanPush = PairCache->CanPush(PusheeInstigatorActor, PusherTargetActor, PusheeInstigator, PusherTarget);
+	}
+	else
+	{
+		bCanPush = PusheeInstigator && PusheeInstigator->CanBePushedBy(PusherTargetActor) &&
+			PusherTarget && PusherTarget->CanPushPawn(PusheeInstigatorActor);
+	}
 
 	// If the pushee can't be pushed or the pusher can't push, we can't do anything
-	if (!bCanBePushed || !bCanPush)
+	if (!bCanPush)
 	{
 		return;
 	}
 
 	// Use this to pass a Push direction, if we compute this later from the Payload Instigator or Target, it will
 	// result in de-sync
-	FVector Direction = PushOption.PusheeActorLocation - PushOption.PusherActorLocation;
+	FVector Direction;
 
 	// Pushee distance from pusher, used later to calculate the normalized distance from pusher. 
-	const float Distance = ScanParams.bDirectionIs2D ? Direction.Size2D() : Direction.Size();
+	float Distance;
+	if (PairCache)
+	{
+		float Distance3D, Distance2D;
+		Direction = PairCache->GetSeparation(PusheeInstigatorActor, PusherTargetActor,
+			PushOption.PusheeActorLocation, PushOption.PusherActorLocation, Distance3D, Distance2D);
+		Distance = GetScanParams().bDirectionIs2D ? Distance2D : Distance3D;
+	}
+	else
+	{
+		Direction = PushOption.PusheeActorLocation - PushOption.PusherActorLocation;
+		Distance = GetScanParams().bDirectionIs2D ? Direction.Size2D() : Direction.Size();
+	}
 	
 	// Way too close to get a valid difference in direction
 	if (Direction.IsNearlyZero(2.5f))
@@ -124,7 +231,7 @@ void UPushPawn_Scan_Base::TriggerPush()
 	}
 	
 	// Normalize the direction
-	Direction = ScanParams.bDirectionIs2D ? Direction.GetSafeNormal2D() : Direction.GetSafeNormal();
+	Direction = GetScanParams().bDirectionIs2D ? Direction.GetSafeNormal2D() : Direction.GetSafeNormal();
 
 	// If we still don't have a valid direction, just push backwards
 	if (!Direction.IsNormalized() || !Direction.IsUnit())
@@ -134,16 +241,46 @@ void UPushPawn_Scan_Base::TriggerPush()
 		Direction = -PushOption.PusheeForwardVector;
 	}
 
+	// Read the strength scalars from the snapshot when available, instead of calling through the interfaces
+	FPushPawnSnapshot* Snapshot = Subsystem ? &Subsystem->GetSnapshot() : nullptr;
+	const int32 PusheeIndex = Snapshot ? Snapshot->FindOrCapture(PusheeInstigatorActor) : INDEX_NONE;
+	const int32 PusherIndex = Snapshot ? Snapshot->FindOrCapture(PusherTargetActor) : INDEX_NONE;
+
 	// Runtime strength scalar
-	const float PusheeStrengthScalar = PusheeInstigator->GetPusheeStrengthScalar();
-	const float PusherStrengthScalar = PusherTarget->GetPusherStrengthScalar();
+	float PusheeStrengthScalar;
+	float PusherStrengthScalar;
 	float StrengthScalar;
 
 	// Runtime strength scalar override
 	float PusheeStrengthScalarOverride = 0.f;
 	float PusherStrengthScalarOverride = 0.f;
-	const bool bOverridePusheeStrength = PusheeInstigator->GetPusheeStrengthOverride(PusheeStrengthScalarOverride);
-	const bool bOverridePusherStrength = PusherTarget->GetPusherStrengthOverride(PusherStrengthScalarOverride);
+	bool bOverridePusheeStrength;
+	bool bOverridePusherStrength;
+
+	if (PusheeIndex != INDEX_NONE)
+	{
+		PusheeStrengthScalar = Snapshot->PusheeStrengthScalars[PusheeIndex];
+		PusheeStrengthScalarOverride = Snapshot->PusheeStrengthOverrides[PusheeIndex];
+		bOverridePusheeStrength = Snapshot->HasFlag(PusheeIndex, EPushPawnSnapshotFlags::PusheeOverride);
+	}
+	else
+	{
+		PusheeStrengthScalar = PusheeInstigator->GetPusheeStrengthScalar();
+		bOverridePusheeStrength = PusheeInstigator->GetPusheeStrengthOverride(PusheeStrengthScalarOverride);
+	}
+
+	if (PusherIndex != INDEX_NONE)
+	{
+		PusherStrengthScalar = Snapshot->PusherStrengthScalars[PusherIndex];
+		PusherStrengthScalarOverride = Snapshot->PusherStrengthOverrides[PusherIndex];
+		bOverridePusherStrength = Snapshot->HasFlag(PusherIndex, EPushPawnSnapshotFlags::PusherOverride);
+	}
+	else
+	{
+		PusherStrengthScalar = PusherTarget->GetPusherStrengthScalar();
+		bOverridePusherStrength = PusherTarget->GetPusherStrengthOverride(PusherStrengthScalarOverride);
+	}
+
 	const bool bStrengthOverride = bOverridePusheeStrength || bOverridePusherStrength;
 
 	// Compute strength scalar
@@ -151,7 +288,7 @@ void UPushPawn_Scan_Base::TriggerPush()
 	{
 		if (bOverridePusheeStrength && bOverridePusherStrength)
 		{
-			switch (ScanParams.StrengthOverrideHandling)
+			switch (GetScanParams().StrengthOverrideHandling)
 			{
 			case EPushPawnOverrideHandling::Average:
 				StrengthScalar = (PusheeStrengthScalarOverride + PusherStrengthScalarOverride) / 2.f;
@@ -182,20 +319,17 @@ void UPushPawn_Scan_Base::TriggerPush()
 	
 	// Allow the target to customize the event data we're about to pass in, in case the ability needs custom data
 	// that only the actor knows.
-	FPushPawnAbilityTargetData* TargetData = new FPushPawnAbilityTargetData(Direction, Distance);
-
-	// The payload data for the Push ability
+	// Target data is pooled, it is serialized immediately if sent to the server
 	FGameplayEventData Payload;
 	Payload.EventTag = FPushPawnTags::PushPawn_PushAbility_Activate;
 	Payload.Instigator = PusheeInstigatorActor;
 	Payload.Target = PusherTargetActor;
-	Payload.TargetData.Add(TargetData);
+	Payload.TargetData.Data.Add(PushPawnScan::AcquirePooled(PooledTargetData, Direction, Distance));
 
 	// We only send the strength scalar if it's not 1.f to save on bandwidth
 	if (bStrengthOverride || !FMath::IsNearlyEqual(StrengthScalar, 1.f))
 	{
-		FPushPawnStrengthTargetData* StrengthTargetData = new FPushPawnStrengthTargetData(StrengthScalar, bStrengthOverride);
-		Payload.TargetData.Add(StrengthTargetData);
+		Payload.TargetData.Data.Add(PushPawnScan::AcquirePooled(PooledStrengthTargetData, StrengthScalar, bStrengthOverride));
 	}
 
 	// If needed we allow the Push target to manipulate the event data
@@ -206,20 +340,116 @@ void UPushPawn_Scan_Base::TriggerPush()
 	AActor* TargetActor = const_cast<AActor*>(Payload.Target.Get());
 
 	// The actor info needed for the Push.
-	FGameplayAbilityActorInfo ActorInfo;
-	ActorInfo.InitFromActor(PusherTargetActor, TargetActor, PushOption.TargetAbilitySystem);
+	FGameplayAbilityActorInfo* ActorInfo = GetTargetActorInfo(PusherTargetActor, TargetActor, PushOption.TargetAbilitySystem);
+
+	// The scan found this option's spec moments ago, don't search for it again while activating it
+	const bool bPrevalidated = PushOption.TargetAbilitySystem == GetAbilitySystemComponentFromActorInfo() &&
+		ConsumePrevalidated(PushOption.TargetPushAbilityHandle);
+	FPushPawnPrevalidatedScope PrevalidatedScope(PushOption.TargetAbilitySystem, PushOption.TargetPushAbilityHandle,
+		bPrevalidated);
 
 	// Trigger the ability using event tag.
 	PushOption.TargetAbilitySystem->TriggerAbilityFromGameplayEvent(
 		PushOption.TargetPushAbilityHandle,
-		&ActorInfo,
+		ActorInfo,
 		FPushPawnTags::PushPawn_PushAbility_Activate,
 		&Payload,
 		*PushOption.TargetAbilitySystem
 	);
 
+	INC_DWORD_STAT(STAT_PushPawn_PushesTriggered);
+#if !UE_BUILD_SHIPPING
+	if (FPushPawnBenchCounters* BenchCounters = FPushPawnBenchmark::GetCounters(this))
+	{
+		// A predicting client sends each push to the server
+		BenchCounters->PushesTriggered++;
+		BenchCounters->PushRPCs += GetCurrentActorInfo()->IsNetAuthority() ? 0 : 1;
+	}
+#endif
+
 	TriggeredPushesSinceLastNetSync++;
 	LastPushTime = GetWorld()->GetTimeSeconds();
+
+	if (MinPushInterval > 0.f && PusherTargetActor)
+	{
+		// Drop pushers whose interval has already elapsed
+		if (LastPushTimeByPusher.Num() >= 16)
+		{
+			for (auto It = LastPushTimeByPusher.CreateIterator(); It; ++It)
+			{
+				if (LastPushTime - It.Value() >= MinPushInterval)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+		LastPushTimeByPusher.Add(PusherTargetActor, LastPushTime);
+	}
+}
+
+FGameplayAbilityActorInfo* UPushPawn_Scan_Base::GetTargetActorInfo(AActor* OwnerActor, AActor* AvatarActor,
+	UAbilitySystemComponent* AbilitySystem)
+{
+	// Drop ability systems that have since been destroyed
+	if (TargetActorInfoCache.Num() >= 16 && !TargetActorInfoCache.Contains(AbilitySystem))
+	{
+		for (auto It = TargetActorInfoCache.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	FGameplayAbilityActorInfo& ActorInfo = TargetActorInfoCache.FindOrAdd(AbilitySystem);
+
+	// InitFromActor() finds the player controller through the owner, which changes on possession
+	const APawn* OwnerPawn = Cast<APawn>(OwnerActor);
+	const bool bControllerChanged = OwnerPawn && ActorInfo.PlayerController.Get() != Cast<APlayerController>(OwnerPawn->GetController());
+
+	if (ActorInfo.AbilitySystemComponent != AbilitySystem || ActorInfo.OwnerActor != OwnerActor ||
+		ActorInfo.AvatarActor != AvatarActor || bControllerChanged)
+	{
+		ActorInfo.InitFromActor(OwnerActor, AvatarActor, AbilitySystem);
+	}
+	return &ActorInfo;
+}
+
+void UPushPawn_Scan_Base::AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const
+{
+	Usage.Options += CurrentOptions.GetAllocatedSize();
+	Usage.Caches += TargetActorInfoCache.GetAllocatedSize();
+	Usage.Caches += LastPushTimeByPusher.GetAllocatedSize();
+	Usage.Caches += PrevalidatedHandles.GetAllocatedSize();
+	if (PooledTargetData.IsValid())
+	{
+		Usage.Caches += sizeof(FPushPawnAbilityTargetData);
+	}
+	if (PooledStrengthTargetData.IsValid())
+	{
+		Usage.Caches += sizeof(FPushPawnStrengthTargetData);
+	}
+}
+
+void UPushPawn_Scan_Base::MarkPrevalidated(FGameplayAbilitySpecHandle Handle)
+{
+	if (PrevalidatedFrame != GFrameCounter)
+	{
+		PrevalidatedFrame = GFrameCounter;
+		PrevalidatedHandles.Reset();
+	}
+	PrevalidatedHandles.AddUnique(Handle);
+}
+
+bool UPushPawn_Scan_Base::ConsumePrevalidated(FGameplayAbilitySpecHandle Handle)
+{
+	return PrevalidatedFrame == GFrameCounter && PrevalidatedHandles.RemoveSingleSwap(Handle) > 0;
+}
+
+const FPushPawnScanParams& UPushPawn_Scan_Base::GetScanParams() const
+{
+	return Profile ? Profile->ScanParams : ScanParams;
 }
 
 float UPushPawn_Scan_Base::GetBaseScanRange(const AActor* AvatarActor) const
@@ -236,7 +466,7 @@ float UPushPawn_Scan_Base::GetBaseScanRange(const AActor* AvatarActor) const
 
 bool UPushPawn_Scan_Base::ShouldWaitForNetSync() const
 {
-	if (!bEnableWaitForNetSync)
+	if (!bEnableWaitForNetSync || bPushesPredictedByMovement)
 	{
 		return false;
 	}
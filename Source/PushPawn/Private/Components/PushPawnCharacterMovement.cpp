@@ -0,0 +1,403 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "Components/PushPawnCharacterMovement.h"
+
+#include "AbilitySystemLog.h"
+#include "Curves/CurveFloat.h"
+#include "GameFramework/Character.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnCharacterMovement)
+
+namespace PushPawnMovement
+{
+	/** Push timings are sent in hundredths of a second, rounded the same way on both ends */
+	static uint8 QuantizeTime(float Seconds)
+	{
+		return (uint8)FMath::Clamp(FMath::RoundToInt(Seconds * 100.f), 0, 255);
+	}
+
+	static float DequantizeTime(uint8 Time)
+	{
+		return Time * 0.01f;
+	}
+}
+
+void FSavedMove_PushPawn::Clear()
+{
+	Super::Clear();
+
+	PushVelocity = FVector::ZeroVector;
+	PushElapsed = 0.f;
+	PushDuration = 0.f;
+	AppliedPushVelocity = FVector::ZeroVector;
+	AddedPushVelocity = FVector::ZeroVector;
+	AddedPushDuration = 0.f;
+}
+
+void FSavedMove_PushPawn::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel,
+	FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	if (UPushPawnCharacterMovement* Movement = Cast<UPushPawnCharacterMovement>(C->GetCharacterMovement()))
+	{
+		PushVelocity = Movement->PushVelocity;
+		PushElapsed = Movement->PushElapsed;
+		PushDuration = Movement->PushDuration;
+		AppliedPushVelocity = Movement->AppliedPushVelocity;
+
+		// Owned by this move now
+		AddedPushVelocity = Movement->AddedPushVelocity;
+		AddedPushDuration = Movement->AddedPushDuration;
+		Movement->AddedPushVelocity = FVector::ZeroVector;
+		Movement->AddedPushDuration = 0.f;
+	}
+}
+
+void FSavedMove_PushPawn::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	// Moves are only prepped when replayed after a correction, which has already given us the server's push state
+	// Continue from it rather than restoring our own, and only add back the pushes we made before this move
+	if (UPushPawnCharacterMovement* Movement = Cast<UPushPawnCharacterMovement>(C->GetCharacterMovement()))
+	{
+		if (AddedPushDuration > 0.f)
+		{
+			Movement->FoldPushVelocity(AddedPushVelocity, AddedPushDuration);
+		}
+	}
+}
+
+bool FSavedMove_PushPawn::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	// The server only receives the push state at the start of the combined move
+	if (HasPush() || static_cast<const FSavedMove_PushPawn*>(NewMove.Get())->HasPush())
+	{
+		return false;
+	}
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+bool FSavedMove_PushPawn::IsImportantMove(const FSavedMovePtr& LastAckedMove) const
+{
+	// Starting a push is important, the server must not miss it
+	if (PushDuration > 0.f && PushElapsed == 0.f)
+	{
+		return true;
+	}
+	return Super::IsImportantMove(LastAckedMove);
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_PushPawn::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_PushPawn());
+}
+
+void FPushPawnNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_PushPawn& PushMove = static_cast<const FSavedMove_PushPawn&>(ClientMove);
+	const bool bHasPush = PushMove.PushElapsed < PushMove.PushDuration;
+	PushVelocity = bHasPush ? PushMove.PushVelocity : FVector::ZeroVector;
+	PushElapsed = bHasPush ? PushPawnMovement::QuantizeTime(PushMove.PushElapsed) : 0;
+	PushDuration = bHasPush ? PushPawnMovement::QuantizeTime(PushMove.PushDuration) : 0;
+}
+
+bool FPushPawnNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
+	UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// Most moves have no push, only spend a bit on those
+	uint8 bHasPush = PushDuration > 0 ? 1 : 0;
+	Ar.SerializeBits(&bHasPush, 1);
+
+	if (bHasPush)
+	{
+		bool bLocalSuccess = true;
+		PushVelocity.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		Ar << PushElapsed;
+		Ar << PushDuration;
+	}
+	else if (Ar.IsLoading())
+	{
+		PushVelocity = FVector::ZeroVector;
+		PushElapsed = 0;
+		PushDuration = 0;
+	}
+
+	return !Ar.IsError();
+}
+
+FPushPawnNetworkMoveDataContainer::FPushPawnNetworkMoveDataContainer()
+{
+	NewMoveData = &MoveData[0];
+	PendingMoveData = &MoveData[1];
+	OldMoveData = &MoveData[2];
+}
+
+void FPushPawnMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement,
+	const FClientAdjustment& PendingAdjustment)
+{
+	Super::ServerFillResponseData(CharacterMovement, PendingAdjustment);
+
+	// Our state after the move being corrected, the same move the rest of the correction describes
+	const UPushPawnCharacterMovement& Movement = static_cast<const UPushPawnCharacterMovement&>(CharacterMovement);
+	const bool bHasPush = Movement.HasPushVelocity();
+	PushVelocity = bHasPush ? Movement.PushVelocity : FVector::ZeroVector;
+	PushElapsed = bHasPush ? PushPawnMovement::QuantizeTime(Movement.PushElapsed) : 0;
+	PushDuration = bHasPush ? PushPawnMovement::QuantizeTime(Movement.PushDuration) : 0;
+	AppliedPushVelocity = Movement.AppliedPushVelocity;
+}
+
+bool FPushPawnMoveResponseDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
+	UPackageMap* PackageMap)
+{
+	if (!Super::Serialize(CharacterMovement, Ar, PackageMap))
+	{
+		return false;
+	}
+
+	// Acknowledged moves keep the client's push state
+	if (!IsCorrection())
+	{
+		return !Ar.IsError();
+	}
+
+	// Most corrections have no push, only spend a bit on those
+	uint8 bHasPush = PushDuration > 0 || !AppliedPushVelocity.IsZero() ? 1 : 0;
+	Ar.SerializeBits(&bHasPush, 1);
+
+	if (bHasPush)
+	{
+		bool bLocalSuccess = true;
+		PushVelocity.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		AppliedPushVelocity.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		Ar << PushElapsed;
+		Ar << PushDuration;
+	}
+	else if (Ar.IsLoading())
+	{
+		PushVelocity = FVector::ZeroVector;
+		AppliedPushVelocity = FVector::ZeroVector;
+		PushElapsed = 0;
+		PushDuration = 0;
+	}
+
+	return !Ar.IsError();
+}
+
+UPushPawnCharacterMovement::UPushPawnCharacterMovement(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, PushDecayCurve(nullptr)
+	, ClientPushTolerance(50.f)
+	, PushVelocity(FVector::ZeroVector)
+	, PushElapsed(0.f)
+	, PushDuration(0.f)
+	, AppliedPushVelocity(FVector::ZeroVector)
+	, AddedPushVelocity(FVector::ZeroVector)
+	, AddedPushDuration(0.f)
+	, bClientPushRejected(false)
+{
+	SetNetworkMoveDataContainer(MoveDataContainer);
+	SetMoveResponseDataContainer(MoveResponseDataContainer);
+}
+
+void UPushPawnCharacterMovement::AddPushVelocity(const FVector& InPushVelocity, float Duration)
+{
+	if (!CharacterOwner || Duration <= 0.f)
+	{
+		return;
+	}
+
+	// Simulated proxies are driven by replicated movement
+	if (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		return;
+	}
+
+	if (Duration > MaxPushDuration)
+	{
+		ABILITY_LOG(Warning, TEXT("PushPawn: %s push duration %.2fs exceeds the %.2fs that can be sent with a move and was clamped"),
+			*GetNameSafe(CharacterOwner), Duration, MaxPushDuration);
+		Duration = MaxPushDuration;
+	}
+
+	// Saved with the next move, so it can be added back when the move is replayed
+	if (CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		AddedPushVelocity += InPushVelocity;
+		AddedPushDuration = FMath::Max(AddedPushDuration, Duration);
+	}
+
+	FoldPushVelocity(InPushVelocity, Duration);
+}
+
+void UPushPawnCharacterMovement::FoldPushVelocity(const FVector& InPushVelocity, float Duration)
+{
+	// Fold the push in progress into the new one, so stacked pushes add up and share a single decay
+	const float RemainingTime = HasPushVelocity() ? PushDuration - PushElapsed : 0.f;
+	const FVector CombinedVelocity = GetCurrentPushVelocity() + InPushVelocity;
+
+	// Round the duration the same way the server will, so the push ends on the same move
+	PushVelocity = CombinedVelocity;
+	PushElapsed = 0.f;
+	PushDuration = PushPawnMovement::DequantizeTime(PushPawnMovement::QuantizeTime(FMath::Max(Duration, RemainingTime)));
+}
+
+FVector UPushPawnCharacterMovement::GetCurrentPushVelocity() const
+{
+	if (!HasPushVelocity())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const float Scalar = PushDecayCurve ? PushDecayCurve->GetFloatValue(PushElapsed / PushDuration) : 1.f;
+	return PushVelocity * Scalar;
+}
+
+void UPushPawnCharacterMovement::ClearPushVelocity()
+{
+	PushVelocity = FVector::ZeroVector;
+	PushElapsed = 0.f;
+	PushDuration = 0.f;
+}
+
+void UPushPawnCharacterMovement::CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration)
+{
+	// Take back the push we added last time so it doesn't compound, unless something already took it away, e.g. a wall
+	if (!AppliedPushVelocity.IsZero())
+	{
+		const float AppliedSpeed = AppliedPushVelocity.Size();
+		const FVector AppliedDirection = AppliedPushVelocity / AppliedSpeed;
+		Velocity -= AppliedDirection * FMath::Clamp(Velocity | AppliedDirection, 0.f, AppliedSpeed);
+		AppliedPushVelocity = FVector::ZeroVector;
+	}
+
+	Super::CalcVelocity(DeltaTime, Friction, bFluid, BrakingDeceleration);
+
+	if (HasPushVelocity())
+	{
+		const FVector CurrentPushVelocity = GetCurrentPushVelocity();
+		Velocity += CurrentPushVelocity;
+
+		// Keep the last push velocity once it finishes, the same as the root motion source it replaces
+		PushElapsed += DeltaTime;
+		if (HasPushVelocity())
+		{
+			AppliedPushVelocity = CurrentPushVelocity;
+		}
+		else
+		{
+			ClearPushVelocity();
+		}
+	}
+}
+
+FNetworkPredictionData_Client* UPushPawnCharacterMovement::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UPushPawnCharacterMovement* MutableThis = const_cast<UPushPawnCharacterMovement*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_PushPawn(*this);
+	}
+	return ClientPredictionData;
+}
+
+void UPushPawnCharacterMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	const FVector& NewAccel)
+{
+	// We apply our own pushes, only take the client's timing when it agrees with us, it can't push itself
+	if (const FPushPawnNetworkMoveData* MoveData = static_cast<const FPushPawnNetworkMoveData*>(GetCurrentNetworkMoveData()))
+	{
+		const FVector ServerPushVelocity = PushVelocity;
+		const float ServerPushElapsed = PushElapsed;
+		const float ServerPushDuration = PushDuration;
+		const FVector ServerCurrentPushVelocity = GetCurrentPushVelocity();
+
+		PushVelocity = MoveData->PushVelocity;
+		PushElapsed = PushPawnMovement::DequantizeTime(MoveData->PushElapsed);
+		PushDuration = PushPawnMovement::DequantizeTime(MoveData->PushDuration);
+
+		bClientPushRejected = !GetCurrentPushVelocity().Equals(ServerCurrentPushVelocity, ClientPushTolerance);
+		if (bClientPushRejected)
+		{
+			PushVelocity = ServerPushVelocity;
+			PushElapsed = ServerPushElapsed;
+			PushDuration = ServerPushDuration;
+		}
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+bool UPushPawnCharacterMovement::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel,
+	const FVector& ClientLoc, const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase,
+	FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	// Otherwise the client keeps pushing from its own state, and is corrected again on every move until the push ends
+	if (bClientPushRejected)
+	{
+		bClientPushRejected = false;
+		return true;
+	}
+
+	return Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientLoc, RelativeClientLoc,
+		ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+}
+
+void UPushPawnCharacterMovement::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData,
+	float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName,
+	bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, FVector ServerGravityDirection)
+{
+	// The response being handled, see FPushPawnMoveResponseDataContainer
+	const FPushPawnMoveResponseDataContainer& Response = static_cast<const FPushPawnMoveResponseDataContainer&>(
+		GetMoveResponseDataContainer());
+
+	PushVelocity = Response.PushVelocity;
+	PushElapsed = PushPawnMovement::DequantizeTime(Response.PushElapsed);
+	PushDuration = PushPawnMovement::DequantizeTime(Response.PushDuration);
+	AppliedPushVelocity = Response.AppliedPushVelocity;
+
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase,
+		bBaseRelativePosition, ServerMovementMode, ServerGravityDirection);
+}
+
+UActorComponent* UPushPawnMovementBackend_Velocity::FindMovementComponent(const AActor* Avatar) const
+{
+	return Cast<UPushPawnCharacterMovement>(Super::FindMovementComponent(Avatar));
+}
+
+int32 UPushPawnMovementBackend_Velocity::ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const
+{
+	UPushPawnCharacterMovement* Movement = Cast<UPushPawnCharacterMovement>(MovementComponent);
+	if (!Movement || !Force.bIsAdditive || Force.StrengthOverTime)
+	{
+		return Super::ApplyPush(MovementComponent, Force);
+	}
+
+	// Leave the vertical velocity to gravity
+	Movement->AddPushVelocity(Force.bEnableGravity ? FVector(Force.Force.X, Force.Force.Y, 0.f) : Force.Force, Force.Duration);
+	return VelocityPushID;
+}
+
+void UPushPawnMovementBackend_Velocity::RemovePush(UActorComponent* MovementComponent, int32 PushID) const
+{
+	// Velocity pushes are folded together and can't be removed individually, they run for their full duration
+	if (PushID != VelocityPushID)
+	{
+		Super::RemovePush(MovementComponent, PushID);
+	}
+}
+
+bool UPushPawnMovementBackend_Velocity::IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const
+{
+	if (PushID == VelocityPushID)
+	{
+		const UPushPawnCharacterMovement* Movement = Cast<UPushPawnCharacterMovement>(MovementComponent);
+		return Movement && Movement->HasPushVelocity();
+	}
+	return Super::IsPushActive(MovementComponent, PushID);
+}
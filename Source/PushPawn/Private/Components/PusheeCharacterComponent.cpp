@@ -0,0 +1,86 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "Components/PusheeCharacterComponent.h"
+
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "PushStatics.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PusheeCharacterComponent)
+
+void UPusheeCharacterComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (CharacterOwner)
+	{
+		CachedShape = UPushStatics::GetDefaultPusheeCollisionShape(CharacterOwner, CachedShapeRotation, CollisionShapeType);
+		bHasCachedShape = true;
+	}
+}
+
+bool UPusheeCharacterComponent::IsPushable() const
+{
+	if (!IsValid(CharacterOwner) || CharacterOwner->IsPendingKillPending())
+	{
+		return false;
+	}
+
+	const UCharacterMovementComponent* MovementComponent = CharacterOwner->GetCharacterMovement();
+	if (!MovementComponent || MovementComponent->MovementMode == MOVE_None)
+	{
+		return false;
+	}
+
+	return UPushStatics::MatchesTagQuery(CharacterOwner, PushableTagQuery);
+}
+
+bool UPusheeCharacterComponent::CanBePushedBy(const AActor* PusherActor) const
+{
+	if (!IsValid(PusherActor) || PusherActor == GetOwner())
+	{
+		return false;
+	}
+
+	return UPushStatics::MatchesTagQuery(PusherActor, PushedByTagQuery);
+}
+
+bool UPusheeCharacterComponent::GetPusheeStrengthOverride(float& Strength) const
+{
+	if (bOverrideStrength)
+	{
+		Strength = StrengthOverride;
+		return true;
+	}
+	return false;
+}
+
+FVector UPusheeCharacterComponent::GetPusheeAcceleration() const
+{
+	const UCharacterMovementComponent* MovementComponent = CharacterOwner ? CharacterOwner->GetCharacterMovement() : nullptr;
+	return MovementComponent ? MovementComponent->GetCurrentAcceleration() : FVector::ZeroVector;
+}
+
+FVector UPusheeCharacterComponent::GetPusheeVelocity() const
+{
+	return CharacterOwner ? CharacterOwner->GetVelocity() : FVector::ZeroVector;
+}
+
+bool UPusheeCharacterComponent::IsPusheeMovingOnGround() const
+{
+	const UCharacterMovementComponent* MovementComponent = CharacterOwner ? CharacterOwner->GetCharacterMovement() : nullptr;
+	return MovementComponent && MovementComponent->IsMovingOnGround();
+}
+
+FCollisionShape UPusheeCharacterComponent::GetPusheeCollisionShape(FQuat& ShapeRotation) const
+{
+	if (bHasCachedShape)
+	{
+		ShapeRotation = CachedShapeRotation;
+		return CachedShape;
+	}
+
+	return CharacterOwner ? UPushStatics::GetDefaultPusheeCollisionShape(CharacterOwner, ShapeRotation, CollisionShapeType) :
+		FCollisionShape();
+}
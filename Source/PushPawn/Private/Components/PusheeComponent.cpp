@@ -0,0 +1,108 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "Components/PusheeComponent.h"
+
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "PushStatics.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PusheeComponent)
+
+void UPusheeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bUseOverlapSensor && GetWorld() && GetWorld()->IsGameWorld())
+	{
+		CreateSensor();
+	}
+}
+
+void UPusheeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Sensor)
+	{
+		Sensor->OnComponentBeginOverlap.RemoveAll(this);
+		Sensor->OnComponentEndOverlap.RemoveAll(this);
+		Sensor->DestroyComponent();
+		Sensor = nullptr;
+	}
+	SensorOverlaps.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPusheeComponent::CreateSensor()
+{
+	AActor* Owner = GetOwner();
+	if (!Owner || !Owner->GetRootComponent() || Sensor)
+	{
+		return;
+	}
+
+	Sensor = NewObject<USphereComponent>(Owner, TEXT("PushPawnSensor"));
+	Sensor->SetupAttachment(Owner->GetRootComponent());
+	Sensor->SetSphereRadius(SensorRadius, false);
+	Sensor->SetCanEverAffectNavigation(false);
+	Sensor->SetGenerateOverlapEvents(true);
+	Sensor->SetHiddenInGame(true);
+
+	// Use the dedicated profile if the project has one, otherwise only overlap pawns
+	FCollisionResponseTemplate ProfileTemplate;
+	if (UCollisionProfile::Get()->GetProfileTemplate(SensorCollisionProfile, ProfileTemplate))
+	{
+		Sensor->SetCollisionProfileName(SensorCollisionProfile, false);
+	}
+	else
+	{
+		Sensor->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Sensor->SetCollisionObjectType(ECC_WorldDynamic);
+		Sensor->SetCollisionResponseToAllChannels(ECR_Ignore);
+		Sensor->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+	}
+
+	Sensor->OnComponentBeginOverlap.AddDynamic(this, &ThisClass::OnSensorBeginOverlap);
+	Sensor->OnComponentEndOverlap.AddDynamic(this, &ThisClass::OnSensorEndOverlap);
+	Sensor->RegisterComponent();
+
+	// Pick up anyone who is already inside the sensor
+	Sensor->UpdateOverlaps();
+}
+
+void UPusheeComponent::OnSensorBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (!OtherActor || OtherActor == GetOwner() || !OtherComp)
+	{
+		return;
+	}
+
+	// Only push-capable actors whose categories can push us can wake the scan
+	const IPusherTarget* PusherTarget = UPushStatics::GetPusherTarget(OtherActor);
+	if (!PusherTarget || !PusherTarget->IsPushCapable() || !PusherTarget->GetPusherFilter().CanPush(GetPusheeFilter()))
+	{
+		return;
+	}
+
+	const int32 NumOverlaps = SensorOverlaps.Num();
+	SensorOverlaps.Add(OtherComp);
+
+	// First neighbor has arrived, resume scanning
+	if (NumOverlaps == 0 && SensorOverlaps.Num() > 0)
+	{
+		OnSensorScanPaused.ExecuteIfBound(false);
+	}
+}
+
+void UPusheeComponent::OnSensorEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// Last neighbor has left, pause scanning
+	if (SensorOverlaps.Remove(OtherComp) > 0 && SensorOverlaps.Num() == 0)
+	{
+		OnSensorScanPaused.ExecuteIfBound(true);
+	}
+}
@@ -0,0 +1,51 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "Components/PusherCharacterComponent.h"
+
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "PushStatics.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PusherCharacterComponent)
+
+void UPusherCharacterComponent::GatherPushOptions(const FPushQuery& PushQuery, FPushOptionBuilder& OptionBuilder)
+{
+	UPushStatics::GatherPushOptions(PushAbility, PawnOwner, PushQuery, OptionBuilder);
+}
+
+bool UPusherCharacterComponent::IsPushCapable() const
+{
+	if (!PushAbility || !IsValid(CharacterOwner) || CharacterOwner->IsPendingKillPending())
+	{
+		return false;
+	}
+
+	const UCharacterMovementComponent* MovementComponent = CharacterOwner->GetCharacterMovement();
+	if (!MovementComponent || MovementComponent->MovementMode == MOVE_None)
+	{
+		return false;
+	}
+
+	return UPushStatics::MatchesTagQuery(CharacterOwner, PushCapableTagQuery);
+}
+
+bool UPusherCharacterComponent::CanPushPawn(const AActor* PusheeActor) const
+{
+	if (!IsValid(PusheeActor) || PusheeActor == GetOwner())
+	{
+		return false;
+	}
+
+	return UPushStatics::MatchesTagQuery(PusheeActor, CanPushTagQuery);
+}
+
+bool UPusherCharacterComponent::GetPusherStrengthOverride(float& Strength) const
+{
+	if (bOverrideStrength)
+	{
+		Strength = StrengthOverride;
+		return true;
+	}
+	return false;
+}
@@ -2,17 +2,39 @@
 
 #include "PushPawn.h"
 
+#include "PushPawnStats.h"
+#include "PushPawnMovementBackend.h"
+#include "Components/PushPawnCharacterMovement.h"
+
 #define LOCTEXT_NAMESPACE "FPushPawnModule"
 
+DEFINE_STAT(STAT_PushPawn_Scans);
+DEFINE_STAT(STAT_PushPawn_LazyGrants);
+DEFINE_STAT(STAT_PushPawn_OptionChanges);
+DEFINE_STAT(STAT_PushPawn_OptionChangesSuppressed);
+DEFINE_STAT(STAT_PushPawn_ContactsHeld);
+DEFINE_STAT(STAT_PushPawn_PushesTriggered);
+DEFINE_STAT(STAT_PushPawn_PushesSuppressed);
+DEFINE_STAT(STAT_PushPawn_PairCacheHits);
+DEFINE_STAT(STAT_PushPawn_ClientPushesVerified);
+DEFINE_STAT(STAT_PushPawn_ClientPushesRejected);
+DEFINE_STAT(STAT_PushPawn_FallbackScans);
+
+LLM_DEFINE_TAG(PushPawn);
+
 void FPushPawnModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	UPushPawnMovementBackend::RegisterBackend(UPushPawnMovementBackend_Character::StaticClass());
+	UPushPawnMovementBackend::RegisterBackend(UPushPawnMovementBackend_Velocity::StaticClass());
 }
 
 void FPushPawnModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	UPushPawnMovementBackend::UnregisterBackend(UPushPawnMovementBackend_Velocity::StaticClass());
+	UPushPawnMovementBackend::UnregisterBackend(UPushPawnMovementBackend_Character::StaticClass());
 }
 
 #undef LOCTEXT_NAMESPACE
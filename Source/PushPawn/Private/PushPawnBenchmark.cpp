@@ -0,0 +1,493 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnBenchmark.h"
+
+#if !UE_BUILD_SHIPPING
+#include "AbilitySystemLog.h"
+#include "Async/Async.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+
+namespace FPushPawnCVars
+{
+	FAutoConsoleCommand CmdPushPawnBenchStart(
+		TEXT("p.PushPawn.Bench.Start"),
+		TEXT("Drive every locally controlled pawn in every world and measure de-sync and network cost.\n")
+		TEXT("Args: [Converge|Cross|Orbit] [Seconds, default 30]. Results are written as JSON to Saved/PushPawn/"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			EPushPawnBenchScenario Scenario = EPushPawnBenchScenario::Converge;
+			if (Args.Num() > 0)
+			{
+				if (Args[0].Equals(TEXT("Cross"), ESearchCase::IgnoreCase))
+				{
+					Scenario = EPushPawnBenchScenario::Cross;
+				}
+				else if (Args[0].Equals(TEXT("Orbit"), ESearchCase::IgnoreCase))
+				{
+					Scenario = EPushPawnBenchScenario::Orbit;
+				}
+			}
+			const float Duration = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 30.f;
+			FPushPawnBenchmark::Start(Scenario, Duration > 0.f ? Duration : 30.f);
+		}));
+
+	FAutoConsoleCommand CmdPushPawnBenchStop(
+		TEXT("p.PushPawn.Bench.Stop"),
+		TEXT("Stop the running PushPawn benchmark and report its results"),
+		FConsoleCommandDelegate::CreateStatic(&FPushPawnBenchmark::Stop));
+}
+
+namespace PushPawnBench
+{
+	static const TCHAR* LexToString(EPushPawnBenchScenario Scenario)
+	{
+		switch (Scenario)
+		{
+		case EPushPawnBenchScenario::Cross: return TEXT("Cross");
+		case EPushPawnBenchScenario::Orbit: return TEXT("Orbit");
+		default: return TEXT("Converge");
+		}
+	}
+
+	static const TCHAR* LexToString(ENetMode NetMode)
+	{
+		switch (NetMode)
+		{
+		case NM_DedicatedServer: return TEXT("DedicatedServer");
+		case NM_ListenServer: return TEXT("ListenServer");
+		case NM_Client: return TEXT("Client");
+		default: return TEXT("Standalone");
+		}
+	}
+
+	/** Reverse the cross scenario this often, so the two groups keep running through each other */
+	static constexpr float CrossPeriod = 4.f;
+
+	/** Client moves kept per player, the server must process a move before it falls out */
+	static constexpr int32 MaxClientMoves = 64;
+}
+
+TUniquePtr<FPushPawnBenchmark> FPushPawnBenchmark::Instance;
+
+FPushPawnBenchmark::FPushPawnBenchmark(EPushPawnBenchScenario InScenario, float InDuration)
+	: Scenario(InScenario)
+	, Duration(InDuration)
+	, StartTime(FPlatformTime::Seconds())
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPushPawnBenchmark::Tick));
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FPushPawnBenchmark::OnWorldPostActorTick);
+}
+
+FPushPawnBenchmark::~FPushPawnBenchmark()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+}
+
+void FPushPawnBenchmark::Start(EPushPawnBenchScenario Scenario, float Duration)
+{
+	if (Instance.IsValid())
+	{
+		Stop();
+	}
+
+	Instance = TUniquePtr<FPushPawnBenchmark>(new FPushPawnBenchmark(Scenario, Duration));
+
+	// Every world is reported, even if nothing happens in it
+	if (GEngine)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && World->IsGameWorld())
+			{
+				Instance->FindOrAddWorld(World);
+			}
+		}
+	}
+
+	ABILITY_LOG(Display, TEXT("PushPawn: Benchmark %s started for %.1fs across %d worlds"),
+		PushPawnBench::LexToString(Scenario), Duration, Instance->Worlds.Num());
+}
+
+void FPushPawnBenchmark::Stop()
+{
+	if (!Instance.IsValid())
+	{
+		return;
+	}
+
+	const FString Json = Instance->Report();
+	const FString FileName = FString::Printf(TEXT("Bench_%s_%s.json"), PushPawnBench::LexToString(Instance->Scenario),
+		*FDateTime::Now().ToString());
+	const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PushPawn"), FileName);
+	FFileHelper::SaveStringToFile(Json, *FilePath);
+
+	ABILITY_LOG(Display, TEXT("PushPawn: Benchmark results written to %s\n%s"), *FilePath, *Json);
+
+	Instance.Reset();
+}
+
+FPushPawnBenchCounters* FPushPawnBenchmark::FindOrAddCounters(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? &FindOrAddWorld(World).Counters : nullptr;
+}
+
+FPushPawnBenchWorld& FPushPawnBenchmark::FindOrAddWorld(UWorld* World)
+{
+	FPushPawnBenchWorld* BenchWorld = Worlds.Find(World);
+	if (!BenchWorld)
+	{
+		BenchWorld = &Worlds.Add(World);
+		BenchWorld->World = World;
+		BenchWorld->Name = World->GetName();
+		BenchWorld->NetMode = PushPawnBench::LexToString(World->GetNetMode());
+	}
+	return *BenchWorld;
+}
+
+bool FPushPawnBenchmark::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPushPawnBenchmark::Tick);
+
+	const float Time = static_cast<float>(FPlatformTime::Seconds() - StartTime);
+	if (Time >= Duration)
+	{
+		// Stopping destroys us, which can't happen while the ticker is still calling us
+		TickerHandle.Reset();
+		AsyncTask(ENamedThreads::GameThread, [this]()
+		{
+			if (Instance.Get() == this)
+			{
+				Stop();
+			}
+		});
+		return false;
+	}
+
+	for (TPair<TObjectKey<UWorld>, FPushPawnBenchWorld>& BenchWorld : Worlds)
+	{
+		DriveWorld(BenchWorld.Value, Time);
+	}
+
+	SampleLatencyOffset();
+	return true;
+}
+
+void FPushPawnBenchmark::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	if (World && World->IsGameWorld())
+	{
+		FPushPawnBenchWorld& BenchWorld = FindOrAddWorld(World);
+		PollCorrections(BenchWorld);
+		SampleMoves(BenchWorld);
+	}
+}
+
+void FPushPawnBenchmark::PollCorrections(FPushPawnBenchWorld& BenchWorld) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPushPawnBenchmark::PollCorrections);
+
+	UWorld* World = BenchWorld.World.Get();
+	if (!World)
+	{
+		return;
+	}
+
+	// Read from the prediction data, so corrections are counted for any character movement component
+	FPushPawnBenchCounters& Counters = BenchWorld.Counters;
+	for (TActorIterator<ACharacter> It(World); It; ++It)
+	{
+		UCharacterMovementComponent* Movement = It->GetCharacterMovement();
+		if (!Movement)
+		{
+			continue;
+		}
+
+		FPushPawnBenchMovement& Entry = BenchWorld.Movements.FindOrAdd(Movement);
+
+		// Sent when the net driver flushes, which is after us, and cleared once sent
+		if (Movement->HasPredictionData_Server())
+		{
+			const FClientAdjustment& Adjustment = Movement->GetPredictionData_Server_Character()->PendingAdjustment;
+			if (Adjustment.TimeStamp > 0.f && !Adjustment.bAckGoodMove && Adjustment.TimeStamp != Entry.LastAdjustmentTimeStamp)
+			{
+				Entry.LastAdjustmentTimeStamp = Adjustment.TimeStamp;
+				Counters.CorrectionsSent++;
+			}
+		}
+
+		if (Movement->HasPredictionData_Client())
+		{
+			const FNetworkPredictionData_Client_Character* ClientData = Movement->GetPredictionData_Client_Character();
+			if (ClientData->LastCorrectionTime > 0.f && ClientData->LastCorrectionTime != Entry.LastCorrectionTime)
+			{
+				Entry.LastCorrectionTime = ClientData->LastCorrectionTime;
+				Counters.Corrections++;
+				Counters.CorrectionErrorSum += ClientData->LastCorrectionDelta;
+				Counters.MaxCorrectionError = FMath::Max(Counters.MaxCorrectionError, ClientData->LastCorrectionDelta);
+			}
+		}
+	}
+}
+
+void FPushPawnBenchmark::SampleMoves(FPushPawnBenchWorld& BenchWorld)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPushPawnBenchmark::SampleMoves);
+
+	UWorld* World = BenchWorld.World.Get();
+	if (!World)
+	{
+		return;
+	}
+
+	// Only possible when the server and its clients share this process, matched by player
+	for (TActorIterator<ACharacter> It(World); It; ++It)
+	{
+		UCharacterMovementComponent* Movement = It->GetCharacterMovement();
+		const APlayerState* PlayerState = It->GetPlayerState();
+		if (!Movement || !Movement->UpdatedComponent || !PlayerState)
+		{
+			continue;
+		}
+
+		FPushPawnBenchMovement& Entry = BenchWorld.Movements.FindOrAdd(Movement);
+
+		if (World->GetNetMode() == NM_Client && It->IsLocallyControlled() && Movement->HasPredictionData_Client())
+		{
+			const FNetworkPredictionData_Client_Character* ClientData = Movement->GetPredictionData_Client_Character();
+			TArray<FPushPawnBenchMove>& Moves = ClientMoves.FindOrAdd(PlayerState->GetPlayerId());
+
+			// Time stamps are periodically reset, see MinTimeBetweenTimeStampResets
+			if (ClientData->SavedMoves.Num() > 0 && ClientData->SavedMoves.Last()->TimeStamp < Entry.LastMoveTimeStamp)
+			{
+				Moves.Reset();
+				Entry.LastMoveTimeStamp = 0.f;
+			}
+
+			for (const FSavedMovePtr& Move : ClientData->SavedMoves)
+			{
+				if (Move->TimeStamp > Entry.LastMoveTimeStamp)
+				{
+					Moves.Add({ Move->TimeStamp, Move->SavedLocation });
+					Entry.LastMoveTimeStamp = Move->TimeStamp;
+				}
+			}
+
+			if (Moves.Num() > PushPawnBench::MaxClientMoves)
+			{
+				Moves.RemoveAt(0, Moves.Num() - PushPawnBench::MaxClientMoves);
+			}
+		}
+		else if (World->GetNetMode() != NM_Client && Movement->HasPredictionData_Server())
+		{
+			// Our location is the result of the last move we processed
+			const float TimeStamp = Movement->GetPredictionData_Server_Character()->CurrentClientTimeStamp;
+			if (TimeStamp == Entry.LastMoveTimeStamp)
+			{
+				continue;
+			}
+			Entry.LastMoveTimeStamp = TimeStamp;
+
+			const TArray<FPushPawnBenchMove>* Moves = ClientMoves.Find(PlayerState->GetPlayerId());
+			const FPushPawnBenchMove* ClientMove = Moves ? Moves->FindByPredicate([TimeStamp](const FPushPawnBenchMove& Move)
+			{
+				return Move.TimeStamp == TimeStamp;
+			}) : nullptr;
+
+			if (ClientMove)
+			{
+				const float Error = FVector::Dist(ClientMove->Location, Movement->UpdatedComponent->GetComponentLocation());
+				PositionErrorSum += Error;
+				MaxPositionError = FMath::Max(MaxPositionError, Error);
+				NumPositionErrorSamples++;
+			}
+		}
+	}
+}
+
+void FPushPawnBenchmark::DriveWorld(FPushPawnBenchWorld& BenchWorld, float Time) const
+{
+	UWorld* World = BenchWorld.World.Get();
+	if (!World)
+	{
+		return;
+	}
+
+	// The crowd moves relative to where it started, not where it has since moved to
+	if (!BenchWorld.Center.IsSet())
+	{
+		FVector Sum = FVector::ZeroVector;
+		int32 Count = 0;
+		for (TActorIterator<APawn> It(World); It; ++It)
+		{
+			Sum += It->GetActorLocation();
+			Count++;
+		}
+		if (Count == 0)
+		{
+			return;
+		}
+		BenchWorld.Center = Sum / Count;
+	}
+	const FVector Center = BenchWorld.Center.GetValue();
+
+	const bool bReverse = FMath::FloorToInt32(Time / PushPawnBench::CrossPeriod) % 2 == 1;
+	for (TActorIterator<APawn> It(World); It; ++It)
+	{
+		APawn* Pawn = *It;
+		if (!Pawn->IsLocallyControlled() || !Pawn->GetMovementComponent())
+		{
+			continue;
+		}
+
+		const FVector ToCenter = (Center - Pawn->GetActorLocation()).GetSafeNormal2D();
+		FVector Input;
+		switch (Scenario)
+		{
+		case EPushPawnBenchScenario::Cross:
+		{
+			// Split by player, so each pawn is in the same group on the server and every client
+			const APlayerState* PlayerState = Pawn->GetPlayerState();
+			const uint32 Group = PlayerState ? static_cast<uint32>(PlayerState->GetPlayerId()) : Pawn->GetUniqueID();
+			Input = FVector(((Group & 1) == 0) != bReverse ? 1.f : -1.f, 0.f, 0.f);
+			break;
+		}
+		case EPushPawnBenchScenario::Orbit:
+			// Pull inwards a little, or the orbit drifts outwards
+			Input = (FVector::CrossProduct(ToCenter, FVector::UpVector) + ToCenter * 0.25f).GetSafeNormal2D();
+			break;
+		default:
+			Input = ToCenter;
+			break;
+		}
+		Pawn->AddMovementInput(Input);
+	}
+}
+
+void FPushPawnBenchmark::SampleLatencyOffset()
+{
+	// Only possible when the server and its clients share this process
+	const UWorld* ServerWorld = nullptr;
+	TArray<const UWorld*, TInlineAllocator<8>> ClientWorlds;
+	for (const TPair<TObjectKey<UWorld>, FPushPawnBenchWorld>& BenchWorld : Worlds)
+	{
+		const UWorld* World = BenchWorld.Value.World.Get();
+		const ENetMode NetMode = World ? World->GetNetMode() : NM_Standalone;
+		if (NetMode == NM_Client)
+		{
+			ClientWorlds.Add(World);
+		}
+		else if (NetMode == NM_ListenServer || NetMode == NM_DedicatedServer)
+		{
+			ServerWorld = World;
+		}
+	}
+	if (!ServerWorld || ClientWorlds.Num() == 0)
+	{
+		return;
+	}
+
+	// Match pawns across worlds by their player
+	TMap<int32, FVector> ServerLocations;
+	for (TActorIterator<APawn> It(ServerWorld); It; ++It)
+	{
+		if (const APlayerState* PlayerState = It->GetPlayerState())
+		{
+			ServerLocations.Add(PlayerState->GetPlayerId(), It->GetActorLocation());
+		}
+	}
+
+	for (const UWorld* ClientWorld : ClientWorlds)
+	{
+		for (TActorIterator<APawn> It(ClientWorld); It; ++It)
+		{
+			const APlayerState* PlayerState = It->GetPlayerState();
+			const FVector* ServerLocation = PlayerState ? ServerLocations.Find(PlayerState->GetPlayerId()) : nullptr;
+			if (ServerLocation)
+			{
+				const float Offset = FVector::Dist(*ServerLocation, It->GetActorLocation());
+				LatencyOffsetSum += Offset;
+				MaxLatencyOffset = FMath::Max(MaxLatencyOffset, Offset);
+				NumLatencyOffsetSamples++;
+			}
+		}
+	}
+}
+
+FString FPushPawnBenchmark::Report() const
+{
+	const float Elapsed = FMath::Max(static_cast<float>(FPlatformTime::Seconds() - StartTime), UE_KINDA_SMALL_NUMBER);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Scenario"), FString(PushPawnBench::LexToString(Scenario)));
+	Writer->WriteValue(TEXT("Duration"), Elapsed);
+
+	Writer->WriteObjectStart(TEXT("PositionError"));
+	Writer->WriteValue(TEXT("Samples"), NumPositionErrorSamples);
+	Writer->WriteValue(TEXT("Average"), NumPositionErrorSamples > 0 ? PositionErrorSum / NumPositionErrorSamples : 0.0);
+	Writer->WriteValue(TEXT("Max"), MaxPositionError);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteObjectStart(TEXT("LatencyOffset"));
+	Writer->WriteValue(TEXT("Samples"), NumLatencyOffsetSamples);
+	Writer->WriteValue(TEXT("Average"), NumLatencyOffsetSamples > 0 ? LatencyOffsetSum / NumLatencyOffsetSamples : 0.0);
+	Writer->WriteValue(TEXT("Max"), MaxLatencyOffset);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteArrayStart(TEXT("Worlds"));
+	for (const TPair<TObjectKey<UWorld>, FPushPawnBenchWorld>& Entry : Worlds)
+	{
+		const FPushPawnBenchWorld& BenchWorld = Entry.Value;
+		const FPushPawnBenchCounters& Counters = BenchWorld.Counters;
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Name"), BenchWorld.Name);
+		Writer->WriteValue(TEXT("NetMode"), BenchWorld.NetMode);
+
+#if DO_ENABLE_NET_TEST
+		// Emulation applied with Net PktLag and Net PktLoss
+		const UWorld* World = BenchWorld.World.Get();
+		if (const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr)
+		{
+			Writer->WriteValue(TEXT("PktLag"), NetDriver->PacketSimulationSettings.PktLag);
+			Writer->WriteValue(TEXT("PktLoss"), NetDriver->PacketSimulationSettings.PktLoss);
+		}
+#endif
+
+		Writer->WriteValue(TEXT("NetSyncs"), Counters.NetSyncs);
+		Writer->WriteValue(TEXT("PushesTriggered"), Counters.PushesTriggered);
+		Writer->WriteValue(TEXT("PushRPCs"), Counters.PushRPCs);
+		Writer->WriteValue(TEXT("PushRPCsPerSecond"), Counters.PushRPCs / Elapsed);
+		Writer->WriteValue(TEXT("ClientPushesVerified"), Counters.ClientPushesVerified);
+		Writer->WriteValue(TEXT("ClientPushesRejected"), Counters.ClientPushesRejected);
+		Writer->WriteValue(TEXT("FallbackScans"), Counters.FallbackScans);
+		Writer->WriteValue(TEXT("CorrectionsSent"), Counters.CorrectionsSent);
+		Writer->WriteValue(TEXT("Corrections"), Counters.Corrections);
+		Writer->WriteValue(TEXT("AverageCorrectionError"), Counters.Corrections > 0 ?
+			Counters.CorrectionErrorSum / Counters.Corrections : 0.0);
+		Writer->WriteValue(TEXT("MaxCorrectionError"), Counters.MaxCorrectionError);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Json;
+}
+
+#endif
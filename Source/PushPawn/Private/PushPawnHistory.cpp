@@ -0,0 +1,141 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnHistory.h"
+
+#include "GameFramework/Actor.h"
+
+void FPushPawnHistory::Init(int32 InCapacity)
+{
+	Reset();
+
+	Capacity = FMath::Max(InCapacity, 2);
+	Times.SetNumZeroed(Capacity);
+}
+
+void FPushPawnHistory::Add(const AActor* Actor)
+{
+	if (!Actor || Capacity == 0 || Rows.Contains(Actor))
+	{
+		return;
+	}
+
+	int32 Row;
+	if (FreeRows.Num() > 0)
+	{
+		Row = FreeRows.Pop();
+		Actors[Row] = Actor;
+		NumSamples[Row] = 0;
+	}
+	else
+	{
+		Row = Actors.Add(Actor);
+		NumSamples.Add(0);
+		Locations.AddZeroed(Capacity);
+	}
+	Rows.Add(Actor, Row);
+}
+
+void FPushPawnHistory::Remove(const AActor* Actor)
+{
+	int32 Row;
+	if (Rows.RemoveAndCopyValue(Actor, Row))
+	{
+		Actors[Row].Reset();
+		NumSamples[Row] = 0;
+		FreeRows.Add(Row);
+	}
+}
+
+void FPushPawnHistory::Record(double Time)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPushPawnHistory::Record);
+
+	if (Capacity == 0)
+	{
+		return;
+	}
+
+	Times[Head] = Time;
+	for (int32 Row = 0; Row < Actors.Num(); Row++)
+	{
+		// Destroyed without being removed, drop its history rather than leave a gap in it
+		const AActor* Actor = Actors[Row].Get();
+		if (!Actor)
+		{
+			NumSamples[Row] = 0;
+			continue;
+		}
+
+		Locations[Row * Capacity + Head] = Actor->GetActorLocation();
+		NumSamples[Row] = FMath::Min(NumSamples[Row] + 1, Capacity);
+	}
+	Head = (Head + 1) % Capacity;
+}
+
+bool FPushPawnHistory::GetLocationAtTime(const AActor* Actor, double Time, FVector& OutLocation) const
+{
+	const int32* Row = Rows.Find(Actor);
+	const int32 NumValid = Row ? NumSamples[*Row] : 0;
+	if (NumValid == 0)
+	{
+		return false;
+	}
+
+	const FVector* RowLocations = &Locations[*Row * Capacity];
+
+	// Clamp to the ends of the history
+	const int32 Oldest = GetSlot(0, NumValid);
+	const int32 Newest = GetSlot(NumValid - 1, NumValid);
+	if (Time <= Times[Oldest])
+	{
+		OutLocation = RowLocations[Oldest];
+		return true;
+	}
+	if (Time >= Times[Newest])
+	{
+		OutLocation = RowLocations[Newest];
+		return true;
+	}
+
+	// Find the first sample after Time, sample times increase with their order
+	int32 Low = 1;
+	int32 High = NumValid - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Times[GetSlot(Mid, NumValid)] <= Time)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	const int32 Before = GetSlot(Low - 1, NumValid);
+	const int32 After = GetSlot(Low, NumValid);
+	const double Span = Times[After] - Times[Before];
+	const float Alpha = Span > 0.0 ? static_cast<float>((Time - Times[Before]) / Span) : 1.f;
+	OutLocation = FMath::Lerp(RowLocations[Before], RowLocations[After], Alpha);
+	return true;
+}
+
+void FPushPawnHistory::Reset()
+{
+	Capacity = 0;
+	Head = 0;
+	Times.Reset();
+	Locations.Reset();
+	Actors.Reset();
+	NumSamples.Reset();
+	FreeRows.Reset();
+	Rows.Reset();
+}
+
+SIZE_T FPushPawnHistory::GetAllocatedSize() const
+{
+	return Times.GetAllocatedSize() + Locations.GetAllocatedSize() + Actors.GetAllocatedSize() +
+		NumSamples.GetAllocatedSize() + FreeRows.GetAllocatedSize() + Rows.GetAllocatedSize();
+}
@@ -0,0 +1,106 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#include "PushPawnMovementBackend.h"
+
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/RootMotionSource.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnMovementBackend)
+
+TArray<TSubclassOf<UPushPawnMovementBackend>> UPushPawnMovementBackend::Backends;
+
+void UPushPawnMovementBackend::RegisterBackend(TSubclassOf<UPushPawnMovementBackend> BackendClass)
+{
+	if (BackendClass && !BackendClass->HasAnyClassFlags(CLASS_Abstract))
+	{
+		Backends.AddUnique(BackendClass);
+	}
+}
+
+void UPushPawnMovementBackend::UnregisterBackend(TSubclassOf<UPushPawnMovementBackend> BackendClass)
+{
+	Backends.Remove(BackendClass);
+}
+
+const UPushPawnMovementBackend* UPushPawnMovementBackend::FindBackend(const AActor* Avatar, UActorComponent*& OutMovementComponent)
+{
+	OutMovementComponent = nullptr;
+	if (!IsValid(Avatar))
+	{
+		return nullptr;
+	}
+
+	// Later registrations are more specific, give them the first chance
+	for (int32 BackendIndex = Backends.Num() - 1; BackendIndex >= 0; BackendIndex--)
+	{
+		const UPushPawnMovementBackend* Backend = Backends[BackendIndex].GetDefaultObject();
+		if (UActorComponent* MovementComponent = Backend ? Backend->FindMovementComponent(Avatar) : nullptr)
+		{
+			OutMovementComponent = MovementComponent;
+			return Backend;
+		}
+	}
+	return nullptr;
+}
+
+UActorComponent* UPushPawnMovementBackend_Character::FindMovementComponent(const AActor* Avatar) const
+{
+	if (const ACharacter* Character = Cast<ACharacter>(Avatar))
+	{
+		return Character->GetCharacterMovement();
+	}
+	return Avatar->FindComponentByClass<UCharacterMovementComponent>();
+}
+
+bool UPushPawnMovementBackend_Character::CanPush(const UActorComponent* MovementComponent) const
+{
+	const UCharacterMovementComponent* CMC = Cast<UCharacterMovementComponent>(MovementComponent);
+	return CMC && CMC->MovementMode != MOVE_None;
+}
+
+int32 UPushPawnMovementBackend_Character::ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const
+{
+	UCharacterMovementComponent* CMC = Cast<UCharacterMovementComponent>(MovementComponent);
+	if (!CMC)
+	{
+		return INDEX_NONE;
+	}
+
+	const TSharedPtr<FRootMotionSource_ConstantForce> ConstantForce = MakeShared<FRootMotionSource_ConstantForce>();
+	ConstantForce->InstanceName = TEXT("PushPawnForce");
+	ConstantForce->AccumulateMode = Force.bIsAdditive ? ERootMotionAccumulateMode::Additive : ERootMotionAccumulateMode::Override;
+	ConstantForce->Priority = 2;  // Low priority for pushing
+	ConstantForce->Force = Force.Force;
+	ConstantForce->Duration = Force.Duration;
+	ConstantForce->StrengthOverTime = Force.StrengthOverTime;
+	ConstantForce->FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity;
+	if (Force.bEnableGravity)
+	{
+		ConstantForce->Settings.SetFlag(ERootMotionSourceSettingsFlags::IgnoreZAccumulate);
+	}
+
+	const uint16 RootMotionSourceID = CMC->ApplyRootMotionSource(ConstantForce);
+	return RootMotionSourceID != (uint16)ERootMotionSourceID::Invalid ? RootMotionSourceID : INDEX_NONE;
+}
+
+void UPushPawnMovementBackend_Character::RemovePush(UActorComponent* MovementComponent, int32 PushID) const
+{
+	UCharacterMovementComponent* CMC = Cast<UCharacterMovementComponent>(MovementComponent);
+	if (CMC && PushID != INDEX_NONE)
+	{
+		CMC->RemoveRootMotionSourceByID((uint16)PushID);
+	}
+}
+
+bool UPushPawnMovementBackend_Character::IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const
+{
+	const UCharacterMovementComponent* CMC = Cast<UCharacterMovementComponent>(MovementComponent);
+	if (!CMC || PushID == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FRootMotionSource> RMS = CMC->GetRootMotionSourceByID((uint16)PushID);
+	return RMS.IsValid() && !RMS->Status.HasFlag(ERootMotionSourceStatusFlags::Finished);
+}
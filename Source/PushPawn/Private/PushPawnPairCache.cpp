@@ -0,0 +1,115 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnPairCache.h"
+
+#include "IPush.h"
+#include "PushPawnStats.h"
+#include "GameFramework/Actor.h"
+
+bool FPushPawnPairCache::CanPush(const AActor* PusheeActor, const AActor* PusherActor,
+	const IPusheeInstigator* Pushee, const IPusherTarget* Pusher)
+{
+	if (!Pushee || !Pusher)
+	{
+		return false;
+	}
+
+	bool bPusheeIsFirst;
+	FPushPawnPair& Pair = FindOrAdd(PusheeActor, PusherActor, bPusheeIsFirst);
+	const EPushPawnPairFlags CheckedFlag = bPusheeIsFirst ? EPushPawnPairFlags::FirstPushChecked :
+		EPushPawnPairFlags::SecondPushChecked;
+	const EPushPawnPairFlags CanBePushedFlag = bPusheeIsFirst ? EPushPawnPairFlags::FirstCanBePushed :
+		EPushPawnPairFlags::SecondCanBePushed;
+
+	if (EnumHasAnyFlags(Pair.Flags, CheckedFlag))
+	{
+		INC_DWORD_STAT(STAT_PushPawn_PairCacheHits);
+		return EnumHasAnyFlags(Pair.Flags, CanBePushedFlag);
+	}
+
+	// Don't ask the pusher if the pushee already refused
+	Pair.Flags |= CheckedFlag;
+	if (Pushee->CanBePushedBy(PusherActor) && Pusher->CanPushPawn(PusheeActor))
+	{
+		Pair.Flags |= CanBePushedFlag;
+		return true;
+	}
+	return false;
+}
+
+FVector FPushPawnPairCache::GetSeparation(const AActor* PusheeActor, const AActor* PusherActor,
+	const FVector& PusheeLocation, const FVector& PusherLocation, float& OutDistance, float& OutDistance2D)
+{
+	bool bPusheeIsFirst;
+	FPushPawnPair& Pair = FindOrAdd(PusheeActor, PusherActor, bPusheeIsFirst);
+
+	const FVector& FirstLocation = bPusheeIsFirst ? PusheeLocation : PusherLocation;
+	const FVector& SecondLocation = bPusheeIsFirst ? PusherLocation : PusheeLocation;
+
+	if (!EnumHasAnyFlags(Pair.Flags, EPushPawnPairFlags::HasSeparation) || Pair.FirstLocation != FirstLocation ||
+		Pair.SecondLocation != SecondLocation)
+	{
+		Pair.FirstLocation = FirstLocation;
+		Pair.SecondLocation = SecondLocation;
+		Pair.Separation = SecondLocation - FirstLocation;
+		Pair.Distance = Pair.Separation.Size();
+		Pair.Distance2D = Pair.Separation.Size2D();
+		Pair.Flags |= EPushPawnPairFlags::HasSeparation;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_PushPawn_PairCacheHits);
+	}
+
+	OutDistance = Pair.Distance;
+	OutDistance2D = Pair.Distance2D;
+
+	// Separation points from First to Second, we want pusher to pushee
+	return bPusheeIsFirst ? -Pair.Separation : Pair.Separation;
+}
+
+float FPushPawnPairCache::GetNormalizedDistance(const AActor* PusheeActor, const AActor* PusherActor,
+	float DistanceBetween)
+{
+	bool bPusheeIsFirst;
+	FPushPawnPair& Pair = FindOrAdd(PusheeActor, PusherActor, bPusheeIsFirst);
+
+	if (Pair.CombinedRadius < 0.f)
+	{
+		Pair.CombinedRadius = PusheeActor->GetSimpleCollisionRadius() + PusherActor->GetSimpleCollisionRadius();
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_PushPawn_PairCacheHits);
+	}
+
+	// Prevent potential divide by zero issues
+	return Pair.CombinedRadius != 0.f ? (DistanceBetween / Pair.CombinedRadius) : 0.f;
+}
+
+void FPushPawnPairCache::Reset()
+{
+	Pairs.Reset();
+}
+
+FPushPawnPair& FPushPawnPairCache::FindOrAdd(const AActor* PusheeActor, const AActor* PusherActor,
+	bool& bOutPusheeIsFirst)
+{
+	// Results are only valid for the frame they were computed on
+	if (CacheFrame != GFrameCounter)
+	{
+		CacheFrame = GFrameCounter;
+		Pairs.Reset();
+	}
+
+	// Order the key so both pawns of the pair find the same entry
+	const FObjectKey PusheeKey(PusheeActor);
+	const FObjectKey PusherKey(PusherActor);
+	bOutPusheeIsFirst = PusheeKey < PusherKey;
+
+	const TPair<FObjectKey, FObjectKey> Key = bOutPusheeIsFirst ?
+		TPair<FObjectKey, FObjectKey>(PusheeKey, PusherKey) : TPair<FObjectKey, FObjectKey>(PusherKey, PusheeKey);
+
+	return Pairs.FindOrAdd(Key);
+}
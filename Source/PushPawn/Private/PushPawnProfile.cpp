@@ -0,0 +1,115 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnProfile.h"
+
+#include "Curves/CurveFloat.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnProfile)
+
+void FPushPawnCurveLUT::Bake(const UCurveFloat* Curve, int32 NumSamples)
+{
+	Samples.Reset();
+	MinTime = 0.f;
+	InvStep = 0.f;
+
+	if (!Curve)
+	{
+		return;
+	}
+
+	float MaxTime;
+	Curve->GetTimeRange(MinTime, MaxTime);
+
+	// A single key or a flat range only needs one sample
+	const float Range = MaxTime - MinTime;
+	NumSamples = Range > UE_KINDA_SMALL_NUMBER ? FMath::Max(2, NumSamples) : 1;
+	InvStep = NumSamples > 1 ? (NumSamples - 1) / Range : 0.f;
+
+	Samples.SetNumUninitialized(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; Index++)
+	{
+		const float Time = NumSamples > 1 ? MinTime + Range * Index / (NumSamples - 1) : MinTime;
+		Samples[Index] = Curve->GetFloatValue(Time);
+	}
+}
+
+float FPushPawnCurveLUT::Evaluate(float InTime, const UCurveFloat* Fallback) const
+{
+	if (!IsBaked())
+	{
+		return Fallback ? Fallback->GetFloatValue(InTime) : 1.f;
+	}
+	return Sample(InTime);
+}
+
+void UPushPawnProfile::BakeCurves()
+{
+	RadiusVelocityScalarLUT.Bake(ScanParams.RadiusVelocityScalar, CurveResolution);
+	VelocityToStrengthLUT.Bake(ActionParams.VelocityToStrengthCurve, CurveResolution);
+	DistanceToStrengthLUT.Bake(ActionParams.DistanceToStrengthCurve, CurveResolution);
+
+	StrengthEvaluator.Bind(ActionParams, &VelocityToStrengthLUT, &DistanceToStrengthLUT);
+}
+
+void UPushPawnProfile::PostLoad()
+{
+	Super::PostLoad();
+
+	// Curves are loaded before us, as they're hard references
+	BakeCurves();
+
+#if WITH_EDITOR
+	BindCurveChanges();
+#endif
+}
+
+#if WITH_EDITOR
+void UPushPawnProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeCurves();
+	BindCurveChanges();
+}
+
+void UPushPawnProfile::BeginDestroy()
+{
+	UnbindCurveChanges();
+
+	Super::BeginDestroy();
+}
+
+void UPushPawnProfile::BindCurveChanges()
+{
+	UnbindCurveChanges();
+
+	for (UCurveFloat* Curve : { ScanParams.RadiusVelocityScalar.Get(), ActionParams.VelocityToStrengthCurve.Get(),
+		ActionParams.DistanceToStrengthCurve.Get() })
+	{
+		if (Curve && !BoundCurves.Contains(Curve))
+		{
+			Curve->OnUpdateCurve.AddUObject(this, &ThisClass::OnCurveChanged);
+			BoundCurves.Add(Curve);
+		}
+	}
+}
+
+void UPushPawnProfile::UnbindCurveChanges()
+{
+	for (const TWeakObjectPtr<UCurveBase>& Curve : BoundCurves)
+	{
+		if (UCurveBase* BoundCurve = Curve.Get())
+		{
+			BoundCurve->OnUpdateCurve.RemoveAll(this);
+		}
+	}
+	BoundCurves.Reset();
+}
+
+void UPushPawnProfile::OnCurveChanged(UCurveBase* Curve, EPropertyChangeType::Type ChangeType)
+{
+	// The same curves are still referenced, only their keys changed
+	BakeCurves();
+}
+#endif
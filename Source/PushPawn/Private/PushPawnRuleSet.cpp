@@ -0,0 +1,73 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnRuleSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnRuleSet)
+
+uint8 UPushPawnRuleSet::GetCategoryID(const FGameplayTagContainer& Tags) const
+{
+	// IDs past the matrix are treated as uncategorized
+	for (int32 Index = 0; Index < NumIDs - 1; Index++)
+	{
+		if (Tags.HasTag(Categories[Index]))
+		{
+			return static_cast<uint8>(Index + 1);
+		}
+	}
+	return Uncategorized;
+}
+
+void UPushPawnRuleSet::Compile()
+{
+	NumIDs = FMath::Min(Categories.Num(), MAX_uint8 - 1) + 1;
+	Matrix.Init(bCanPushByDefault, NumIDs * NumIDs);
+
+	for (const FPushPawnRule& Rule : Rules)
+	{
+		ForEachMatchingID(Rule.Pusher, [this, &Rule](int32 PusherID)
+		{
+			ForEachMatchingID(Rule.Pushee, [this, &Rule, PusherID](int32 PusheeID)
+			{
+				Matrix[PusherID * NumIDs + PusheeID] = Rule.bCanPush;
+			});
+		});
+	}
+}
+
+void UPushPawnRuleSet::ForEachMatchingID(const FGameplayTag& Tag, TFunctionRef<void(int32)> Func) const
+{
+	// Empty matches everyone, including the uncategorized
+	if (!Tag.IsValid())
+	{
+		for (int32 ID = 0; ID < NumIDs; ID++)
+		{
+			Func(ID);
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < NumIDs - 1; Index++)
+	{
+		if (Categories[Index].MatchesTag(Tag))
+		{
+			Func(Index + 1);
+		}
+	}
+}
+
+void UPushPawnRuleSet::PostLoad()
+{
+	Super::PostLoad();
+
+	Compile();
+}
+
+#if WITH_EDITOR
+void UPushPawnRuleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Compile();
+}
+#endif
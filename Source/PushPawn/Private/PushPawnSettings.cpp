@@ -0,0 +1,8 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnSettings.h"
+
+#include "PushPawnRuleSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnSettings)
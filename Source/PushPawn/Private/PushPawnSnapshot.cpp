@@ -0,0 +1,218 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnSnapshot.h"
+
+#include "IPush.h"
+#include "PushPawnRuleSet.h"
+#include "PushStatics.h"
+#include "GameFramework/Actor.h"
+
+int32 FPushPawnSnapshot::FindOrCapture(const AActor* Actor)
+{
+	const int32* Index = Indices.Find(Actor);
+	if (!Index)
+	{
+		return INDEX_NONE;
+	}
+
+	if (CaptureFrames[*Index] != GFrameCounter)
+	{
+		Capture(*Index);
+	}
+
+	// Destroyed since it was registered
+	return CaptureFrames[*Index] == GFrameCounter ? *Index : INDEX_NONE;
+}
+
+void FPushPawnSnapshot::CaptureAll()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPushPawnSnapshot::CaptureAll);
+
+	for (int32 Index = 0; Index < Actors.Num(); Index++)
+	{
+		if (CaptureFrames[Index] != GFrameCounter)
+		{
+			Capture(Index);
+		}
+	}
+}
+
+bool FPushPawnSnapshot::PassesPushFilter(int32 PusherIndex, int32 PusheeIndex) const
+{
+	if (!PusherFilters[PusherIndex].CanPush(PusheeFilters[PusheeIndex]))
+	{
+		return false;
+	}
+	return !RuleSet || RuleSet->CanPush(CategoryIDs[PusherIndex], CategoryIDs[PusheeIndex]);
+}
+
+FVector FPushPawnSnapshot::GetGroundVelocity(int32 Index) const
+{
+	const FVector& Velocity = Velocities[Index];
+	return HasFlag(Index, EPushPawnSnapshotFlags::MovingOnGround) ? Velocity : FVector(Velocity.X, Velocity.Y, 0.f);
+}
+
+void FPushPawnSnapshot::Rebuild(const TArray<const AActor*>& InActors)
+{
+	Reset();
+
+	const int32 Count = InActors.Num();
+	Actors.Reserve(Count);
+	for (const AActor* Actor : InActors)
+	{
+		Indices.Add(Actor, Actors.Num());
+		Actors.Add(Actor);
+	}
+
+	Locations.SetNumZeroed(Count);
+	Rotations.Init(FQuat::Identity, Count);
+	Velocities.SetNumZeroed(Count);
+	Accelerations.SetNumZeroed(Count);
+	Shapes.SetNum(Count);
+	ShapeRotations.Init(FQuat::Identity, Count);
+	Flags.Init(EPushPawnSnapshotFlags::None, Count);
+	PusheeStrengthScalars.Init(1.f, Count);
+	PusherStrengthScalars.Init(1.f, Count);
+	PusheeStrengthOverrides.SetNumZeroed(Count);
+	PusherStrengthOverrides.SetNumZeroed(Count);
+	PusheeFilters.Init(FPushPawnFilter(), Count);
+	PusherFilters.Init(FPushPawnFilter(), Count);
+	CategoryIDs.Init(UPushPawnRuleSet::Uncategorized, Count);
+
+	// Nothing has been captured yet
+	CaptureFrames.Init(MAX_uint64, Count);
+}
+
+void FPushPawnSnapshot::Reset()
+{
+	Actors.Reset();
+	Locations.Reset();
+	Rotations.Reset();
+	Velocities.Reset();
+	Accelerations.Reset();
+	Shapes.Reset();
+	ShapeRotations.Reset();
+	Flags.Reset();
+	PusheeStrengthScalars.Reset();
+	PusherStrengthScalars.Reset();
+	PusheeStrengthOverrides.Reset();
+	PusherStrengthOverrides.Reset();
+	PusheeFilters.Reset();
+	PusherFilters.Reset();
+	CategoryIDs.Reset();
+	CaptureFrames.Reset();
+	Indices.Reset();
+}
+
+SIZE_T FPushPawnSnapshot::GetAllocatedSize() const
+{
+	return Actors.GetAllocatedSize() + Locations.GetAllocatedSize() + Rotations.GetAllocatedSize() +
+		Velocities.GetAllocatedSize() + Accelerations.GetAllocatedSize() + Shapes.GetAllocatedSize() +
+		ShapeRotations.GetAllocatedSize() + Flags.GetAllocatedSize() + PusheeStrengthScalars.GetAllocatedSize() +
+		PusherStrengthScalars.GetAllocatedSize() + PusheeStrengthOverrides.GetAllocatedSize() +
+		PusherStrengthOverrides.GetAllocatedSize() + PusheeFilters.GetAllocatedSize() + PusherFilters.GetAllocatedSize() +
+		CategoryIDs.GetAllocatedSize() + CaptureFrames.GetAllocatedSize() + Indices.GetAllocatedSize();
+}
+
+void FPushPawnGrid::Build(const FPushPawnSnapshot& Snapshot, float InCellSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPushPawnGrid::Build);
+
+	// Keep the allocations, the same cells are usually occupied frame to frame
+	for (auto& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	CellSize = FMath::Max(1.f, InCellSize);
+	for (int32 Index = 0; Index < Snapshot.Num(); Index++)
+	{
+		if (Snapshot.CaptureFrames[Index] == GFrameCounter)
+		{
+			Cells.FindOrAdd(GetCell(Snapshot.Locations[Index])).Add(Index);
+		}
+	}
+
+	// Drop cells nobody occupies anymore, otherwise every cell ever visited is kept and walked
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		if (It->Value.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FPushPawnGrid::Reset()
+{
+	Cells.Reset();
+}
+
+SIZE_T FPushPawnGrid::GetAllocatedSize() const
+{
+	SIZE_T Size = Cells.GetAllocatedSize();
+	for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Size += Cell.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FPushPawnSnapshot::Capture(int32 Index)
+{
+	const AActor* Actor = Actors[Index].Get();
+	if (!Actor)
+	{
+		return;
+	}
+
+	CaptureFrames[Index] = GFrameCounter;
+	Locations[Index] = Actor->GetActorLocation();
+	Rotations[Index] = Actor->GetActorQuat();
+
+	EPushPawnSnapshotFlags NewFlags = EPushPawnSnapshotFlags::None;
+
+	if (const IPusheeInstigator* Pushee = UPushStatics::GetPusheeInstigator(Actor))
+	{
+		Velocities[Index] = Pushee->GetPusheeVelocity();
+		Accelerations[Index] = UPushStatics::GetPushPawnAcceleration(Pushee);
+		Shapes[Index] = Pushee->GetPusheeCollisionShape(ShapeRotations[Index]);
+		PusheeStrengthScalars[Index] = Pushee->GetPusheeStrengthScalar();
+		PusheeFilters[Index] = Pushee->GetPusheeFilter();
+
+		if (Pushee->IsPushable())
+		{
+			NewFlags |= EPushPawnSnapshotFlags::Pushable;
+		}
+		if (Pushee->IsPusheeMovingOnGround())
+		{
+			NewFlags |= EPushPawnSnapshotFlags::MovingOnGround;
+		}
+		if (UPushStatics::IsPusheeAccelerating(Accelerations[Index]))
+		{
+			NewFlags |= EPushPawnSnapshotFlags::Accelerating;
+		}
+		if (Pushee->GetPusheeStrengthOverride(PusheeStrengthOverrides[Index]))
+		{
+			NewFlags |= EPushPawnSnapshotFlags::PusheeOverride;
+		}
+	}
+
+	if (const IPusherTarget* Pusher = UPushStatics::GetPusherTarget(Actor))
+	{
+		PusherStrengthScalars[Index] = Pusher->GetPusherStrengthScalar();
+		PusherFilters[Index] = Pusher->GetPusherFilter();
+
+		if (Pusher->IsPushCapable())
+		{
+			NewFlags |= EPushPawnSnapshotFlags::PushCapable;
+		}
+		if (Pusher->GetPusherStrengthOverride(PusherStrengthOverrides[Index]))
+		{
+			NewFlags |= EPushPawnSnapshotFlags::PusherOverride;
+		}
+	}
+
+	Flags[Index] = NewFlags;
+}
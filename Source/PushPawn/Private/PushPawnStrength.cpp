@@ -0,0 +1,126 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnStrength.h"
+
+#include "PushPawnProfile.h"
+#include "PushStatics.h"
+#include "PushTypes.h"
+
+#include "Curves/CurveFloat.h"
+
+namespace FPushPawnCVars
+{
+#if !UE_BUILD_SHIPPING
+	static uint32 PushPawnStrengthCVarSerial = 0;
+	static void OnStrengthCVarChanged(IConsoleVariable*)
+	{
+		PushPawnStrengthCVarSerial++;
+	}
+
+	static bool bPushPawnVelocityStrengthScalarDisabled = false;
+	FAutoConsoleVariableRef CVarPushPawnDisableVelocityStrengthScalar(
+		TEXT("p.PushPawn.DisableVelocityScaling"),
+		bPushPawnVelocityStrengthScalarDisabled,
+		TEXT("Disable PushPawn velocity based strength scalar.\n"),
+		FConsoleVariableDelegate::CreateStatic(&OnStrengthCVarChanged),
+		ECVF_Cheat);
+	
+	static bool bPushPawnDistanceStrengthScalarDisabled = false;
+	FAutoConsoleVariableRef CVarPushPawnDisableDistanceStrengthScalar(
+		TEXT("p.PushPawn.DisableDistanceScaling"),
+		bPushPawnDistanceStrengthScalarDisabled,
+		TEXT("Disable PushPawn distance based strength scalar.\n"),
+		FConsoleVariableDelegate::CreateStatic(&OnStrengthCVarChanged),
+		ECVF_Cheat);
+#endif
+}
+
+template<bool bVelocity, bool bDistance, bool bBaked>
+float FPushPawnStrengthEvaluator::EvaluatePolicy(const FPushPawnStrengthEvaluator& Evaluator, const APawn* Pushee,
+	float Distance)
+{
+	float Strength = Evaluator.StrengthScalar;
+
+	// Scale strength based on pushee velocity
+	if constexpr (bVelocity)
+	{
+		const float PusheeSpeed = UPushStatics::GetPawnGroundSpeed(Pushee);
+		if constexpr (bBaked)
+		{
+			Strength *= Evaluator.VelocityLUT->Sample(PusheeSpeed);
+		}
+		else
+		{
+			Strength *= Evaluator.VelocityCurve->GetFloatValue(PusheeSpeed);
+		}
+	}
+
+	// Scale strength based on distance between the pushee & pusher
+	if constexpr (bDistance)
+	{
+		if constexpr (bBaked)
+		{
+			Strength *= Evaluator.DistanceLUT->Sample(Distance);
+		}
+		else
+		{
+			Strength *= Evaluator.DistanceCurve->GetFloatValue(Distance);
+		}
+	}
+
+	return Strength;
+}
+
+void FPushPawnStrengthEvaluator::Bind(const FPushPawnActionParams& Params, const FPushPawnCurveLUT* InVelocityLUT,
+	const FPushPawnCurveLUT* InDistanceLUT)
+{
+	Bind(Params.StrengthScalar, Params.VelocityToStrengthCurve, Params.DistanceToStrengthCurve, InVelocityLUT, InDistanceLUT);
+}
+
+void FPushPawnStrengthEvaluator::Bind(float InStrengthScalar, const UCurveFloat* InVelocityCurve,
+	const UCurveFloat* InDistanceCurve, const FPushPawnCurveLUT* InVelocityLUT, const FPushPawnCurveLUT* InDistanceLUT)
+{
+	StrengthScalar = InStrengthScalar;
+	VelocityCurve = InVelocityCurve;
+	DistanceCurve = InDistanceCurve;
+	VelocityLUT = InVelocityLUT;
+	DistanceLUT = InDistanceLUT;
+	Rebind();
+}
+
+void FPushPawnStrengthEvaluator::Rebind() const
+{
+	bool bVelocity = VelocityCurve != nullptr;
+	bool bDistance = DistanceCurve != nullptr;
+
+#if !UE_BUILD_SHIPPING
+	BoundSerial = GetCVarSerial();
+	bVelocity &= !FPushPawnCVars::bPushPawnVelocityStrengthScalarDisabled;
+	bDistance &= !FPushPawnCVars::bPushPawnDistanceStrengthScalarDisabled;
+#endif
+
+	// Only use the lookup tables if every curve in use has been baked
+	const bool bBaked = (!bVelocity || (VelocityLUT && VelocityLUT->IsBaked())) &&
+		(!bDistance || (DistanceLUT && DistanceLUT->IsBaked()));
+
+	static constexpr FEvaluateFunc Policies[2][2][2] =
+	{
+		{
+			{ &EvaluatePolicy<false, false, false>, &EvaluatePolicy<false, false, true> },
+			{ &EvaluatePolicy<false, true, false>, &EvaluatePolicy<false, true, true> },
+		},
+		{
+			{ &EvaluatePolicy<true, false, false>, &EvaluatePolicy<true, false, true> },
+			{ &EvaluatePolicy<true, true, false>, &EvaluatePolicy<true, true, true> },
+		},
+	};
+	Func = Policies[bVelocity][bDistance][bBaked];
+}
+
+#if !UE_BUILD_SHIPPING
+uint32 FPushPawnStrengthEvaluator::GetCVarSerial()
+{
+	return FPushPawnCVars::PushPawnStrengthCVarSerial;
+}
+#endif
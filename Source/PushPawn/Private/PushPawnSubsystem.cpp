@@ -0,0 +1,922 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnSubsystem.h"
+
+#include "Tasks/AbilityTask_PushPawnScan.h"
+#include "Tasks/AbilityTask_PushPawnSync.h"
+#include "Tasks/AbilityTask_PushPawnForce.h"
+#include "Abilities/PushPawn_Scan_Base.h"
+#include "Abilities/PushPawn_Action_NonInstanced.h"
+#include "PushPawnRuleSet.h"
+#include "PushPawnSettings.h"
+#include "PushPawnStats.h"
+#include "PushPawnBenchmark.h"
+#include "PushStatics.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayTagAssetInterface.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/RootMotionSource.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PushPawnSubsystem)
+
+namespace FPushPawnCVars
+{
+	static int32 PushPawnCentralizedMinParallelBatch = 16;
+	FAutoConsoleVariableRef CVarPushPawnCentralizedMinParallelBatch(
+		TEXT("p.PushPawn.Centralized.MinParallelBatch"),
+		PushPawnCentralizedMinParallelBatch,
+		TEXT("Centralized scan batches smaller than this run on a single thread.\n"),
+		ECVF_Default);
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdPushPawnMemReport(
+		TEXT("p.PushPawn.MemReport"),
+		TEXT("Report memory used by PushPawn per pawn and in total.\n")
+		TEXT("Optionally pass the maximum number of pawns to list, largest first"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&UPushPawnSubsystem::ReportMemory));
+}
+
+namespace PushPawnMemory
+{
+	static const FName PushPawnForceName = TEXT("PushPawnForce");
+
+	static FString ToString(const FPushPawnMemoryUsage& Usage)
+	{
+		return FString::Printf(TEXT("%lld bytes (Abilities %lld, Specs %lld, Scan Tasks %lld, Sync Tasks %lld, ")
+			TEXT("Force Tasks %lld, Options %lld, Caches %lld, Root Motion %lld)"),
+			Usage.GetTotal(), Usage.AbilityInstances, Usage.AbilitySpecs, Usage.ScanTasks, Usage.SyncTasks,
+			Usage.ForceTasks, Usage.Options, Usage.Caches, Usage.RootMotionSources);
+	}
+}
+
+void FPushPawnTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	switch (Phase)
+	{
+	case EPushPawnTickPhase::Prepare: Subsystem->PrepareScans(); break;
+	case EPushPawnTickPhase::Read: Subsystem->ReadScans(); break;
+	case EPushPawnTickPhase::Commit: Subsystem->CommitScans(); break;
+	}
+}
+
+FString FPushPawnTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("UPushPawnSubsystem[%s]"), *UEnum::GetValueAsString(Phase));
+}
+
+FName FPushPawnTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("PushPawnSubsystem"));
+}
+
+UPushPawnSubsystem::UPushPawnSubsystem()
+{
+	PrepareTickFunction.Phase = EPushPawnTickPhase::Prepare;
+	ReadTickFunction.Phase = EPushPawnTickPhase::Read;
+	CommitTickFunction.Phase = EPushPawnTickPhase::Commit;
+
+	for (FPushPawnTickFunction* TickFunction : { &PrepareTickFunction, &ReadTickFunction, &CommitTickFunction })
+	{
+		TickFunction->bCanEverTick = true;
+		TickFunction->bStartWithTickEnabled = false;
+		TickFunction->TickGroup = TG_PostPhysics;
+	}
+
+	// Only the read phase is thread-safe
+	ReadTickFunction.bRunOnAnyThread = true;
+}
+
+UPushPawnSubsystem::~UPushPawnSubsystem() = default;
+
+UPushPawnSubsystem* UPushPawnSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UPushPawnSubsystem>() : nullptr;
+}
+
+void UPushPawnSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Compiled on load
+	const UPushPawnSettings* Settings = GetDefault<UPushPawnSettings>();
+	RuleSet = Settings->RuleSet.LoadSynchronous();
+	Snapshot.RuleSet = RuleSet;
+	BatchSnapshot.RuleSet = RuleSet;
+
+	for (const TSoftClassPtr<UGameplayAbility>& Ability : Settings->PreGrantedPushAbilities)
+	{
+		if (UClass* AbilityClass = Ability.LoadSynchronous())
+		{
+			PreGrantedPushAbilities.AddUnique(AbilityClass);
+		}
+	}
+}
+
+void UPushPawnSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (FPushPawnTickFunction* TickFunction : { &PrepareTickFunction, &ReadTickFunction, &CommitTickFunction })
+	{
+		TickFunction->Subsystem = this;
+		TickFunction->RegisterTickFunction(InWorld.PersistentLevel);
+	}
+
+	ReadTickFunction.AddPrerequisite(this, PrepareTickFunction);
+	CommitTickFunction.AddPrerequisite(this, ReadTickFunction);
+
+	// Only a server verifying client pushes needs to rewind anyone
+	const UPushPawnSettings* Settings = GetDefault<UPushPawnSettings>();
+	const ENetMode NetMode = InWorld.GetNetMode();
+	bRecordHistory = Settings->bVerifyClientPushes && Settings->PositionHistorySamples > 0 &&
+		(NetMode == NM_DedicatedServer || NetMode == NM_ListenServer);
+	if (bRecordHistory)
+	{
+		History.Init(Settings->PositionHistorySamples);
+		for (const auto& Scan : Scans)
+		{
+			History.Add(Scan.Key.ResolveObjectPtr());
+		}
+	}
+
+	// Scans registered before begin play
+	for (const auto& Scan : Scans)
+	{
+		AddMovementPrerequisite(Scan.Key.ResolveObjectPtr());
+	}
+	UpdateTickFunctions();
+}
+
+void UPushPawnSubsystem::Deinitialize()
+{
+	for (FPushPawnTickFunction* TickFunction : { &PrepareTickFunction, &ReadTickFunction, &CommitTickFunction })
+	{
+		if (TickFunction->IsTickFunctionRegistered())
+		{
+			TickFunction->UnRegisterTickFunction();
+		}
+		TickFunction->Subsystem = nullptr;
+	}
+
+	for (const auto& Category : Categories)
+	{
+		if (UAbilitySystemComponent* AbilitySystem = Category.Value.AbilitySystem.Get())
+		{
+			AbilitySystem->RegisterGenericGameplayTagEvent().Remove(Category.Value.TagChangedHandle);
+		}
+		if (AActor* Actor = Category.Key.ResolveObjectPtr())
+		{
+			Actor->OnEndPlay.RemoveDynamic(this, &ThisClass::OnCategoryActorEndPlay);
+		}
+	}
+	Categories.Reset();
+	PairCache.Reset();
+	RuleSet = nullptr;
+	Snapshot.RuleSet = nullptr;
+	PreGrantedPushAbilities.Reset();
+	PendingGrants.Reset();
+
+	Scans.Reset();
+	NumSleepingScans = 0;
+	Snapshot.Reset();
+	ScheduledScans.Reset();
+	BatchScans.Reset();
+	BatchContexts.Reset();
+	BatchSnapshot.Reset();
+	BatchSnapshot.RuleSet = nullptr;
+	bSnapshotDirty = false;
+	bBatchSnapshotDirty = false;
+	Grid.Reset();
+	VerifyWindows.Reset();
+	History.Reset();
+	bRecordHistory = false;
+
+	Super::Deinitialize();
+}
+
+void UPushPawnSubsystem::RegisterScan(const AActor* Avatar, UAbilityTask_PushPawnScan* Scan)
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (Avatar && Scan)
+	{
+		Scans.Add(Avatar, Scan);
+		bSnapshotDirty = true;
+		bBatchSnapshotDirty = true;
+
+		if (bRecordHistory)
+		{
+			History.Add(Avatar);
+		}
+
+		if (PrepareTickFunction.IsTickFunctionRegistered())
+		{
+			AddMovementPrerequisite(Avatar);
+		}
+		UpdateTickFunctions();
+	}
+}
+
+void UPushPawnSubsystem::UnregisterScan(const AActor* Avatar, const UAbilityTask_PushPawnScan* Scan)
+{
+	UnscheduleScan(Scan);
+
+	// Only remove the entry if it still belongs to this scan, the ability may have re-activated
+	const TWeakObjectPtr<UAbilityTask_PushPawnScan>* Existing = Scans.Find(Avatar);
+	if (Existing && (!Existing->IsValid() || Existing->Get() == Scan))
+	{
+		Scans.Remove(Avatar);
+		bSnapshotDirty = true;
+		bBatchSnapshotDirty = true;
+		History.Remove(Avatar);
+
+		RemoveMovementPrerequisite(Avatar);
+		UpdateTickFunctions();
+	}
+}
+
+UAbilityTask_PushPawnScan* UPushPawnSubsystem::FindScan(const AActor* Avatar) const
+{
+	const TWeakObjectPtr<UAbilityTask_PushPawnScan>* Scan = Scans.Find(Avatar);
+	return Scan ? Scan->Get() : nullptr;
+}
+
+FPushPawnSnapshot& UPushPawnSubsystem::GetSnapshot()
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (bSnapshotDirty)
+	{
+		bSnapshotDirty = false;
+
+		TArray<const AActor*> Participants;
+		Participants.Reserve(Scans.Num());
+		for (const auto& Scan : Scans)
+		{
+			if (const AActor* Avatar = Scan.Key.ResolveObjectPtr())
+			{
+				Participants.Add(Avatar);
+			}
+		}
+		Snapshot.Rebuild(Participants);
+
+		for (int32 Index = 0; RuleSet && Index < Participants.Num(); Index++)
+		{
+			Snapshot.CategoryIDs[Index] = GetPushCategory(Participants[Index]);
+		}
+	}
+	return Snapshot;
+}
+
+uint8 UPushPawnSubsystem::GetPushCategory(const AActor* Actor)
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (!RuleSet || !Actor)
+	{
+		return UPushPawnRuleSet::Uncategorized;
+	}
+
+	if (const FPushPawnCategoryEntry* Entry = Categories.Find(Actor))
+	{
+		return Entry->ID;
+	}
+
+	// Not ready to be categorized yet, e.g. the ability system hasn't been initialized, try again next time
+	UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor);
+	if (!AbilitySystem && !Cast<IGameplayTagAssetInterface>(Actor))
+	{
+		return UPushPawnRuleSet::Uncategorized;
+	}
+
+	AActor* MutableActor = const_cast<AActor*>(Actor);
+	FPushPawnCategoryEntry& Entry = Categories.Add(Actor);
+	Entry.ID = ComputePushCategory(Actor, AbilitySystem);
+
+	// Recompute when tags are added or removed, IGameplayTagAssetInterface has no such event so it is evaluated once
+	if (AbilitySystem)
+	{
+		Entry.AbilitySystem = AbilitySystem;
+		Entry.TagChangedHandle = AbilitySystem->RegisterGenericGameplayTagEvent().AddUObject(this,
+			&ThisClass::OnCategoryTagChanged, TWeakObjectPtr<AActor>(MutableActor));
+	}
+	MutableActor->OnEndPlay.AddUniqueDynamic(this, &ThisClass::OnCategoryActorEndPlay);
+
+	return Entry.ID;
+}
+
+bool UPushPawnSubsystem::PassesPushRules(const AActor* Pusher, const AActor* Pushee)
+{
+	return !RuleSet || RuleSet->CanPush(GetPushCategory(Pusher), GetPushCategory(Pushee));
+}
+
+bool UPushPawnSubsystem::VerifyClientPush(const AActor* Pushee, const AActor* Pusher, const FVector& Direction,
+	float Distance, bool bDistance2D)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawnSubsystem::VerifyClientPush);
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	const UPushPawnSettings* Settings = GetDefault<UPushPawnSettings>();
+	if (!Settings->bVerifyClientPushes)
+	{
+		return true;
+	}
+
+	bool bVerified = IsValid(Pushee) && IsValid(Pusher) && PassesPushRules(Pusher, Pushee);
+
+	// Rate limit each pushee over a one second window
+	if (bVerified && Settings->MaxVerifiedPushesPerSecond > 0)
+	{
+		const double Now = GetWorld()->GetTimeSeconds();
+		if (VerifyWindows.Num() >= 64 && !VerifyWindows.Contains(Pushee))
+		{
+			for (auto It = VerifyWindows.CreateIterator(); It; ++It)
+			{
+				if (Now - It.Value().StartTime >= 1.0)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		FPushPawnVerifyWindow& Window = VerifyWindows.FindOrAdd(Pushee);
+		if (Now - Window.StartTime >= 1.0)
+		{
+			Window.StartTime = Now;
+			Window.NumPushes = 0;
+		}
+		bVerified = ++Window.NumPushes <= Settings->MaxVerifiedPushesPerSecond;
+	}
+
+	// The client can only have been pushed if its scan could have found the pusher, and roughly where it claims we are
+	if (bVerified)
+	{
+		const FVector Separation = Pushee->GetActorLocation() - GetRewoundLocation(Pusher, Pushee);
+		const float ServerDistance = bDistance2D ? Separation.Size2D() : Separation.Size();
+		const UAbilityTask_PushPawnScan* PusheeScan = FindScan(Pushee);
+		const float ContactDistance = PusheeScan ? PusheeScan->GetMaxContactDistance(Pusher) :
+			UPushStatics::GetPusheeRadius2D(Pushee) + UPushStatics::GetPusheeRadius2D(Pusher);
+		bVerified = ServerDistance <= ContactDistance + Settings->VerifyDistanceTolerance &&
+			FMath::Abs(ServerDistance - Distance) <= Settings->VerifyDistanceTolerance;
+
+		// When overlapping this closely the client picks a random direction, matches UPushPawn_Scan_Base::TriggerPush()
+		if (bVerified && !Separation.IsNearlyZero(2.5f))
+		{
+			const FVector ServerDirection = bDistance2D ? Separation.GetSafeNormal2D() : Separation.GetSafeNormal();
+			const float MinDot = FMath::Cos(FMath::DegreesToRadians(Settings->VerifyDirectionTolerance));
+			bVerified = (ServerDirection | Direction.GetSafeNormal()) >= MinDot;
+		}
+	}
+
+	if (bVerified)
+	{
+		INC_DWORD_STAT(STAT_PushPawn_ClientPushesVerified);
+#if !UE_BUILD_SHIPPING
+		if (FPushPawnBenchCounters* BenchCounters = FPushPawnBenchmark::GetCounters(this))
+		{
+			BenchCounters->ClientPushesVerified++;
+		}
+#endif
+		return true;
+	}
+
+	// Find out for ourselves what the client should be doing
+	INC_DWORD_STAT(STAT_PushPawn_ClientPushesRejected);
+#if !UE_BUILD_SHIPPING
+	if (FPushPawnBenchCounters* BenchCounters = FPushPawnBenchmark::GetCounters(this))
+	{
+		BenchCounters->ClientPushesRejected++;
+	}
+#endif
+	if (UAbilityTask_PushPawnScan* Scan = FindScan(Pushee))
+	{
+		Scan->BeginFallbackScan(Settings->FallbackScanDuration);
+	}
+	return false;
+}
+
+FVector UPushPawnSubsystem::GetRewoundLocation(const AActor* Actor, const AActor* Viewer) const
+{
+	FVector Location = Actor->GetActorLocation();
+	if (!bRecordHistory)
+	{
+		return Location;
+	}
+
+	// The client saw other pawns as they were a round trip ago, our update took half of it to arrive and its push the other half
+	const APawn* ViewerPawn = Cast<APawn>(Viewer);
+	const APlayerState* PlayerState = ViewerPawn ? ViewerPawn->GetPlayerState() : nullptr;
+	if (!PlayerState)
+	{
+		return Location;
+	}
+
+	const float RewindTime = FMath::Min(PlayerState->ExactPing * 0.001f, GetDefault<UPushPawnSettings>()->MaxRewindTime);
+	History.GetLocationAtTime(Actor, GetWorld()->GetTimeSeconds() - RewindTime, Location);
+	return Location;
+}
+
+uint8 UPushPawnSubsystem::ComputePushCategory(const AActor* Actor, const UAbilitySystemComponent* AbilitySystem) const
+{
+	FGameplayTagContainer Tags;
+	if (AbilitySystem)
+	{
+		AbilitySystem->GetOwnedGameplayTags(Tags);
+	}
+	else if (const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Actor))
+	{
+		TagInterface->GetOwnedGameplayTags(Tags);
+	}
+	return RuleSet->GetCategoryID(Tags);
+}
+
+void UPushPawnSubsystem::OnCategoryTagChanged(const FGameplayTag Tag, int32 NewCount, TWeakObjectPtr<AActor> WeakActor)
+{
+	const AActor* Actor = WeakActor.Get();
+	FPushPawnCategoryEntry* Entry = Actor && RuleSet ? Categories.Find(Actor) : nullptr;
+	if (!Entry)
+	{
+		return;
+	}
+
+	Entry->ID = ComputePushCategory(Actor, Entry->AbilitySystem.Get());
+
+	// The read phase works on the other buffer, so this is safe to write at any time on the game thread
+	const int32 Index = Snapshot.Find(Actor);
+	if (Index != INDEX_NONE)
+	{
+		Snapshot.CategoryIDs[Index] = Entry->ID;
+	}
+
+	// The other buffer picks up the change when it is rebuilt
+	bBatchSnapshotDirty = true;
+}
+
+void UPushPawnSubsystem::OnCategoryActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	RemovePushCategory(Actor);
+}
+
+void UPushPawnSubsystem::RemovePushCategory(const AActor* Actor)
+{
+	const FPushPawnCategoryEntry* Entry = Categories.Find(Actor);
+	if (!Entry)
+	{
+		return;
+	}
+
+	if (UAbilitySystemComponent* AbilitySystem = Entry->AbilitySystem.Get())
+	{
+		AbilitySystem->RegisterGenericGameplayTagEvent().Remove(Entry->TagChangedHandle);
+	}
+	if (AActor* MutableActor = const_cast<AActor*>(Actor))
+	{
+		MutableActor->OnEndPlay.RemoveDynamic(this, &ThisClass::OnCategoryActorEndPlay);
+	}
+	Categories.Remove(Actor);
+}
+
+void UPushPawnSubsystem::SetScanSleeping(bool bIsSleeping)
+{
+	NumSleepingScans = FMath::Max(0, NumSleepingScans + (bIsSleeping ? 1 : -1));
+}
+
+void UPushPawnSubsystem::WakeScan(const AActor* Avatar)
+{
+	// Nothing is asleep, skip the lookup
+	if (NumSleepingScans == 0)
+	{
+		return;
+	}
+
+	if (UAbilityTask_PushPawnScan* Scan = FindScan(Avatar))
+	{
+		Scan->WakeUp();
+	}
+}
+
+void UPushPawnSubsystem::ScheduleScan(UAbilityTask_PushPawnScan* Scan, float Delay)
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	const double DueTime = GetWorld()->GetTimeSeconds() + Delay;
+	for (FPushPawnScheduledScan& Scheduled : ScheduledScans)
+	{
+		if (Scheduled.Scan == Scan)
+		{
+			Scheduled.DueTime = DueTime;
+			return;
+		}
+	}
+	ScheduledScans.Add({ Scan, DueTime });
+}
+
+void UPushPawnSubsystem::UnscheduleScan(const UAbilityTask_PushPawnScan* Scan)
+{
+	ScheduledScans.RemoveAllSwap([Scan](const FPushPawnScheduledScan& Scheduled)
+	{
+		return !Scheduled.Scan.IsValid() || Scheduled.Scan.Get() == Scan;
+	});
+}
+
+void UPushPawnSubsystem::PreGrantPushAbilities(UAbilitySystemComponent* AbilitySystem,
+	const TArray<TSubclassOf<UGameplayAbility>>& Abilities, bool bImmediate)
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (!AbilitySystem || !AbilitySystem->IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+
+	// Batching waits for our tick functions, which don't run until the world begins play
+	const bool bGrantNow = bImmediate || GetDefault<UPushPawnSettings>()->MaxAbilityGrantsPerFrame <= 0 ||
+		!PrepareTickFunction.IsTickFunctionRegistered();
+
+	for (const TArray<TSubclassOf<UGameplayAbility>>* AbilityList : { &PreGrantedPushAbilities, &Abilities })
+	{
+		for (const TSubclassOf<UGameplayAbility>& Ability : *AbilityList)
+		{
+			if (!Ability)
+			{
+				continue;
+			}
+
+			if (bGrantNow)
+			{
+				GrantPushAbility(AbilitySystem, Ability);
+			}
+			else
+			{
+				PendingGrants.AddUnique({ AbilitySystem, Ability });
+			}
+		}
+	}
+	UpdateTickFunctions();
+}
+
+void UPushPawnSubsystem::GrantPushAbility(UAbilitySystemComponent* AbilitySystem, TSubclassOf<UGameplayAbility> Ability)
+{
+	if (AbilitySystem && Ability && !AbilitySystem->FindAbilitySpecFromClass(Ability))
+	{
+		AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability, 1, INDEX_NONE));
+	}
+}
+
+void UPushPawnSubsystem::ProcessPendingGrants()
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (PendingGrants.Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawnSubsystem::ProcessPendingGrants);
+
+	const int32 Budget = GetDefault<UPushPawnSettings>()->MaxAbilityGrantsPerFrame;
+	const int32 NumGrants = Budget > 0 ? FMath::Min(Budget, PendingGrants.Num()) : PendingGrants.Num();
+	for (int32 Index = 0; Index < NumGrants; Index++)
+	{
+		const FPushPawnPendingGrant& Grant = PendingGrants[Index];
+		GrantPushAbility(Grant.AbilitySystem.Get(), Grant.Ability);
+	}
+	PendingGrants.RemoveAt(0, NumGrants);
+	UpdateTickFunctions();
+}
+
+void UPushPawnSubsystem::PrepareScans()
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	ProcessPendingGrants();
+
+	// Movement has ticked, record where everyone ended up this frame
+	if (bRecordHistory)
+	{
+		History.Record(GetWorld()->GetTimeSeconds());
+	}
+
+	BatchScans.Reset();
+	BatchContexts.Reset();
+
+	if (ScheduledScans.Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawnSubsystem::PrepareScans);
+
+	// Take every due scan, preparing can reschedule so collect them first
+	TArray<UAbilityTask_PushPawnScan*> DueScans;
+	const double TimeSeconds = GetWorld()->GetTimeSeconds();
+	for (int32 Index = ScheduledScans.Num() - 1; Index >= 0; Index--)
+	{
+		const FPushPawnScheduledScan& Scheduled = ScheduledScans[Index];
+		if (!Scheduled.Scan.IsValid())
+		{
+			ScheduledScans.RemoveAtSwap(Index);
+		}
+		else if (Scheduled.DueTime <= TimeSeconds)
+		{
+			DueScans.Add(Scheduled.Scan.Get());
+			ScheduledScans.RemoveAtSwap(Index);
+		}
+	}
+
+	BatchScans.Reserve(DueScans.Num());
+	BatchContexts.Reserve(DueScans.Num());
+	for (UAbilityTask_PushPawnScan* Scan : DueScans)
+	{
+		FPushPawnScanContext Context;
+		if (Scan->PrepareScan(Context))
+		{
+			BatchScans.Add(Scan);
+			BatchContexts.Add(MoveTemp(Context));
+		}
+	}
+
+	if (BatchScans.Num() == 0)
+	{
+		return;
+	}
+
+	// Registration may have changed while preparing, resolve rows only once the snapshot is settled
+	GetSnapshot().CaptureAll();
+
+	// Hand the captured buffer to the batch, game thread captures continue in the previous batch's buffer
+	Swap(Snapshot, BatchSnapshot);
+	Swap(bSnapshotDirty, bBatchSnapshotDirty);
+
+	float MaxQueryRadius = 0.f;
+	for (int32 Index = 0; Index < BatchScans.Num(); Index++)
+	{
+		FPushPawnScanContext& Context = BatchContexts[Index];
+		Context.SnapshotIndex = BatchSnapshot.FindOrCapture(Context.AvatarActor);
+
+		// Time-to-contact looks as far as anyone can close on us before our longest scan interval
+		const FPushPawnScanParams& ScanParams = BatchScans[Index]->GetScanParams();
+		const float ClosingDistance = ScanParams.bTimeToContactScheduling ?
+			ScanParams.MaxClosingSpeed * ScanParams.MaxScanInterval : 0.f;
+		MaxQueryRadius = FMath::Max(MaxQueryRadius, UPushStatics::GetShapeRadius2D(Context.Shape) + ClosingDistance);
+	}
+
+	float MaxParticipantRadius = 0.f;
+	for (const FCollisionShape& Shape : BatchSnapshot.Shapes)
+	{
+		MaxParticipantRadius = FMath::Max(MaxParticipantRadius, UPushStatics::GetShapeRadius2D(Shape));
+	}
+
+	Grid.Build(BatchSnapshot, MaxQueryRadius + MaxParticipantRadius);
+}
+
+void UPushPawnSubsystem::ReadScans()
+{
+	if (BatchScans.Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawnSubsystem::ReadScans);
+
+	const EParallelForFlags Flags = BatchScans.Num() < FPushPawnCVars::PushPawnCentralizedMinParallelBatch ?
+		EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+	ParallelFor(BatchScans.Num(), [this](int32 Index)
+	{
+		BatchScans[Index]->ExecuteCentralizedScan(BatchContexts[Index], BatchSnapshot, Grid);
+	}, Flags);
+}
+
+void UPushPawnSubsystem::CommitScans()
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (BatchScans.Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPushPawnSubsystem::CommitScans);
+
+	// Resolve candidates before committing, anyone closing on us must be awake to push us back
+	for (FPushPawnScanContext& Context : BatchContexts)
+	{
+		if (Context.CandidateIndex != INDEX_NONE)
+		{
+			Context.CandidateActor = BatchSnapshot.Actors[Context.CandidateIndex];
+		}
+		for (const int32 ClosingIndex : Context.ClosingIndices)
+		{
+			WakeScan(BatchSnapshot.Actors[ClosingIndex].Get());
+		}
+	}
+
+	for (int32 Index = 0; Index < BatchScans.Num(); Index++)
+	{
+		if (IsValid(BatchScans[Index]))
+		{
+			BatchScans[Index]->CommitScan(BatchContexts[Index]);
+		}
+	}
+
+	BatchScans.Reset();
+	BatchContexts.Reset();
+}
+
+void UPushPawnSubsystem::AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const
+{
+	Usage.Caches += Scans.GetAllocatedSize() + Snapshot.GetAllocatedSize() +
+		ScheduledScans.GetAllocatedSize() + BatchScans.GetAllocatedSize() + BatchContexts.GetAllocatedSize() +
+		BatchSnapshot.GetAllocatedSize() + Grid.GetAllocatedSize() + Categories.GetAllocatedSize() +
+		PreGrantedPushAbilities.GetAllocatedSize() + PendingGrants.GetAllocatedSize() + VerifyWindows.GetAllocatedSize() +
+		History.GetAllocatedSize() + PairCache.GetAllocatedSize();
+}
+
+void UPushPawnSubsystem::ReportMemory(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	TMap<const AActor*, FPushPawnMemoryUsage> PawnUsage;
+	FPushPawnMemoryUsage SharedUsage;
+	TSet<const UPushPawn_Action_NonInstanced*> SharedAbilities;
+
+	// Ability specs and instances, plus root motion applied by push actions
+	for (TObjectIterator<UAbilitySystemComponent> It; It; ++It)
+	{
+		const UAbilitySystemComponent* AbilitySystem = *It;
+		if (AbilitySystem->GetWorld() != World || !AbilitySystem->AbilityActorInfo.IsValid())
+		{
+			continue;
+		}
+
+		const AActor* Avatar = AbilitySystem->GetAvatarActor_Direct();
+		for (const FGameplayAbilitySpec& Spec : AbilitySystem->GetActivatableAbilities())
+		{
+			if (!Spec.Ability || !Spec.Ability->IsA<UPushPawn_Ability>())
+			{
+				continue;
+			}
+
+			FPushPawnMemoryUsage& Usage = PawnUsage.FindOrAdd(Avatar);
+			Usage.AbilitySpecs += sizeof(FGameplayAbilitySpec);
+
+			for (const UGameplayAbility* Instance : Spec.GetAbilityInstances())
+			{
+				Usage.AbilityInstances += Instance->GetClass()->GetStructureSize();
+				if (const UPushPawn_Scan_Base* Scan = Cast<UPushPawn_Scan_Base>(Instance))
+				{
+					Scan->AccumulateMemoryUsage(Usage);
+				}
+			}
+
+			// Non-instanced abilities share the class default object between every pawn
+			if (const UPushPawn_Action_NonInstanced* Action = Cast<UPushPawn_Action_NonInstanced>(Spec.Ability))
+			{
+				SharedAbilities.Add(Action);
+			}
+		}
+
+		if (const ACharacter* Character = Cast<ACharacter>(Avatar))
+		{
+			if (const UCharacterMovementComponent* CMC = Character->GetCharacterMovement())
+			{
+				for (const TSharedPtr<FRootMotionSource>& RootMotionSource : CMC->CurrentRootMotion.RootMotionSources)
+				{
+					if (RootMotionSource.IsValid() && RootMotionSource->InstanceName == PushPawnMemory::PushPawnForceName)
+					{
+						PawnUsage.FindOrAdd(Avatar).RootMotionSources += sizeof(FRootMotionSource_ConstantForce);
+					}
+				}
+			}
+		}
+	}
+
+	for (const UPushPawn_Action_NonInstanced* Action : SharedAbilities)
+	{
+		Action->AccumulateMemoryUsage(SharedUsage);
+	}
+
+	// Tasks, grouped by the pawn they belong to
+	for (TObjectIterator<UAbilityTask> It; It; ++It)
+	{
+		const UAbilityTask* Task = *It;
+		if (Task->GetWorld() != World)
+		{
+			continue;
+		}
+
+		const int64 TaskSize = Task->GetClass()->GetStructureSize();
+		if (const UAbilityTask_PushPawnScan* ScanTask = Cast<UAbilityTask_PushPawnScan>(Task))
+		{
+			FPushPawnMemoryUsage& Usage = PawnUsage.FindOrAdd(Task->GetAvatarActor());
+			Usage.ScanTasks += TaskSize;
+			ScanTask->AccumulateMemoryUsage(Usage);
+		}
+		else if (Task->IsA<UAbilityTask_PushPawnSync>())
+		{
+			PawnUsage.FindOrAdd(Task->GetAvatarActor()).SyncTasks += TaskSize;
+		}
+		else if (Task->IsA<UAbilityTask_PushPawnForce>())
+		{
+			PawnUsage.FindOrAdd(Task->GetAvatarActor()).ForceTasks += TaskSize;
+		}
+	}
+
+	if (const UPushPawnSubsystem* Subsystem = World->GetSubsystem<UPushPawnSubsystem>())
+	{
+		Subsystem->AccumulateMemoryUsage(SharedUsage);
+	}
+
+	// Largest first
+	PawnUsage.ValueSort([](const FPushPawnMemoryUsage& A, const FPushPawnMemoryUsage& B)
+	{
+		return A.GetTotal() > B.GetTotal();
+	});
+
+	const int32 MaxListed = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : PawnUsage.Num();
+
+	FPushPawnMemoryUsage PawnTotal;
+	int32 Listed = 0;
+	Ar.Logf(TEXT("PushPawn memory for %s:"), *World->GetName());
+	for (const TPair<const AActor*, FPushPawnMemoryUsage>& Entry : PawnUsage)
+	{
+		PawnTotal += Entry.Value;
+		if (Listed++ < MaxListed)
+		{
+			Ar.Logf(TEXT("  %s: %s"), *GetNameSafe(Entry.Key), *PushPawnMemory::ToString(Entry.Value));
+		}
+	}
+
+	FPushPawnMemoryUsage Total = PawnTotal;
+	Total += SharedUsage;
+
+	const int64 AveragePerPawn = PawnUsage.Num() > 0 ? PawnTotal.GetTotal() / PawnUsage.Num() : 0;
+	Ar.Logf(TEXT("Pawns: %d, average %lld bytes per pawn"), PawnUsage.Num(), AveragePerPawn);
+	Ar.Logf(TEXT("Per pawn total: %s"), *PushPawnMemory::ToString(PawnTotal));
+	Ar.Logf(TEXT("Shared: %s"), *PushPawnMemory::ToString(SharedUsage));
+	Ar.Logf(TEXT("Total: %s"), *PushPawnMemory::ToString(Total));
+}
+
+bool UPushPawnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPushPawnSubsystem::UpdateTickFunctions()
+{
+	// Registered once the world begins play, until then there is nothing to enable
+	if (!PrepareTickFunction.IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	// Disabled tick functions cost nothing per frame, and can be toggled safely from within our own ticks
+	const bool bWantsTick = Scans.Num() > 0 || PendingGrants.Num() > 0;
+	if (PrepareTickFunction.IsTickFunctionEnabled() != bWantsTick)
+	{
+		for (FPushPawnTickFunction* TickFunction : { &PrepareTickFunction, &ReadTickFunction, &CommitTickFunction })
+		{
+			TickFunction->SetTickFunctionEnable(bWantsTick);
+		}
+	}
+}
+
+void UPushPawnSubsystem::AddMovementPrerequisite(const AActor* Avatar)
+{
+	const APawn* Pawn = Cast<APawn>(Avatar);
+	if (UPawnMovementComponent* MovementComponent = Pawn ? Pawn->GetMovementComponent() : nullptr)
+	{
+		PrepareTickFunction.AddPrerequisite(MovementComponent, MovementComponent->PrimaryComponentTick);
+	}
+}
+
+void UPushPawnSubsystem::RemoveMovementPrerequisite(const AActor* Avatar)
+{
+	const APawn* Pawn = Cast<APawn>(Avatar);
+	if (UPawnMovementComponent* MovementComponent = Pawn ? Pawn->GetMovementComponent() : nullptr)
+	{
+		PrepareTickFunction.RemovePrerequisite(MovementComponent, MovementComponent->PrimaryComponentTick);
+	}
+}
@@ -12,31 +12,18 @@
 #include "Components/SphereComponent.h"
 #include "IPush.h"
 #include "PushQuery.h"
+#include "PushPawnProfile.h"
+#include "PushPawnStrength.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayTagAssetInterface.h"
 
 #include "Engine/OverlapResult.h"
 #include "Curves/CurveFloat.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PushStatics)
 
-namespace FPushPawnCVars
-{
-#if !UE_BUILD_SHIPPING
-	static bool bPushPawnVelocityStrengthScalarDisabled = false;
-	FAutoConsoleVariableRef CVarPushPawnDisableVelocityStrengthScalar(
-		TEXT("p.PushPawn.DisableVelocityScaling"),
-		bPushPawnVelocityStrengthScalarDisabled,
-		TEXT("Disable PushPawn velocity based strength scalar.\n"),
-		ECVF_Cheat);
-	
-	static bool bPushPawnDistanceStrengthScalarDisabled = false;
-	FAutoConsoleVariableRef CVarPushPawnDisableDistanceStrengthScalar(
-		TEXT("p.PushPawn.DisableDistanceScaling"),
-		bPushPawnDistanceStrengthScalarDisabled,
-		TEXT("Disable PushPawn distance based strength scalar.\n"),
-		ECVF_Cheat);
-#endif
-}
-
 float SafeDivide(float A, float B)
 {
 	// Prevent potential divide by zero issues
@@ -184,50 +171,9 @@ float UPushStatics::GetNormalizedPushDistance(const AActor* Pushee, const AActor
 
 float UPushStatics::GetPushStrength(const APawn* Pushee, float Distance, const FPushPawnActionParams& Params)
 {
-	// Get the strength from the curve and apply the scalar
-	float Strength = Params.StrengthScalar;
-	
-	// Scale strength based on pushee velocity
-	if (Params.VelocityToStrengthCurve)
-	{
-		bool bEvaluateVelocityToStrengthCurve = true;
-
-#if !UE_BUILD_SHIPPING
-		if (FPushPawnCVars::bPushPawnVelocityStrengthScalarDisabled)
-		{
-			bEvaluateVelocityToStrengthCurve = false;
-		}
-#endif
-
-		if (bEvaluateVelocityToStrengthCurve)
-		{
-			// Get the speed of the pushee
-			const float PusheeSpeed = GetPawnGroundSpeed(Pushee);
-
-			// Get the strength from the curve and apply the scalar
-			Strength *= Params.VelocityToStrengthCurve->GetFloatValue(PusheeSpeed);	
-		}
-	}
-
-	// Scale strength based on distance between the pushee & pusher
-	if (Params.DistanceToStrengthCurve)
-	{
-		bool bEvaluateDistanceToStrengthCurve = true;
-
-#if !UE_BUILD_SHIPPING
-		if (FPushPawnCVars::bPushPawnDistanceStrengthScalarDisabled)
-		{
-			bEvaluateDistanceToStrengthCurve = false;
-		}
-#endif
-		
-		if (bEvaluateDistanceToStrengthCurve)
-		{
-			Strength *= Params.DistanceToStrengthCurve->GetFloatValue(Distance);	
-		}
-	}
-
-	return Strength;
+	FPushPawnStrengthEvaluator Evaluator;
+	Evaluator.Bind(Params);
+	return Evaluator.Evaluate(Pushee, Distance);
 }
 
 float UPushStatics::CalculatePushStrength(const APawn* Pushee, bool bOverrideStrength, float StrengthScalar,
@@ -240,51 +186,30 @@ float UPushStatics::CalculatePushStrength(const APawn* Pushee, bool bOverrideStr
 	return GetPushStrength(Pushee, NormalizedDistance, Params) * StrengthScalar;
 }
 
-float UPushStatics::GetPushStrengthSimple(const APawn* Pushee, const UCurveFloat* VelocityToStrengthCurve, const UCurveFloat* DistanceToStrengthCurve, float Distance, float StrengthScalar)
+float UPushStatics::GetPushStrengthFromProfile(const APawn* Pushee, float Distance, const UPushPawnProfile* Profile)
 {
-	float Strength = StrengthScalar;
-	 
-	// Scale strength based on pushee velocity
-	if (VelocityToStrengthCurve)
+	if (!Profile)
 	{
-		bool bEvaluateVelocityToStrengthCurve = true;
-
-#if !UE_BUILD_SHIPPING
-		if (FPushPawnCVars::bPushPawnVelocityStrengthScalarDisabled)
-		{
-			bEvaluateVelocityToStrengthCurve = false;
-		}
-#endif
-
-		if (bEvaluateVelocityToStrengthCurve)
-		{
-			// Get the speed of the pushee
-			const float PusheeSpeed = GetPawnGroundSpeed(Pushee);
-
-			// Get the strength from the curve and apply the scalar
-			Strength *= VelocityToStrengthCurve->GetFloatValue(PusheeSpeed);
-		}
+		return GetPushStrength(Pushee, Distance, FPushPawnActionParams());
 	}
+	return Profile->StrengthEvaluator.Evaluate(Pushee, Distance);
+}
 
-	// Scale strength based on distance between the pushee & pusher
-	if (DistanceToStrengthCurve)
+float UPushStatics::CalculatePushStrengthFromProfile(const APawn* Pushee, bool bOverrideStrength, float StrengthScalar,
+	float NormalizedDistance, const UPushPawnProfile* Profile)
+{
+	if (bOverrideStrength)
 	{
-		bool bEvaluateDistanceToStrengthCurve = true;
-
-#if !UE_BUILD_SHIPPING
-		if (FPushPawnCVars::bPushPawnDistanceStrengthScalarDisabled)
-		{
-			bEvaluateDistanceToStrengthCurve = false;
-		}
-#endif
-
-		if (bEvaluateDistanceToStrengthCurve)
-		{
-			Strength *= DistanceToStrengthCurve->GetFloatValue(Distance);	
-		}
+		return StrengthScalar;
 	}
+	return GetPushStrengthFromProfile(Pushee, NormalizedDistance, Profile) * StrengthScalar;
+}
 
-	return Strength;
+float UPushStatics::GetPushStrengthSimple(const APawn* Pushee, const UCurveFloat* VelocityToStrengthCurve, const UCurveFloat* DistanceToStrengthCurve, float Distance, float StrengthScalar)
+{
+	FPushPawnStrengthEvaluator Evaluator;
+	Evaluator.Bind(StrengthScalar, VelocityToStrengthCurve, DistanceToStrengthCurve);
+	return Evaluator.Evaluate(Pushee, Distance);
 }
 
 float UPushStatics::CalculatePushDirection(const FVector& Direction, const FRotator& BaseRotation)
@@ -482,6 +407,51 @@ const IPusherTarget* UPushStatics::GetPusherTarget(const AActor* Actor)
 	return nullptr;
 }
 
+bool UPushStatics::PassesPushFilter(const IPusherTarget* Pusher, const IPusheeInstigator* Pushee)
+{
+	if (!Pusher || !Pushee)
+	{
+		return true;
+	}
+	return Pusher->GetPusherFilter().CanPush(Pushee->GetPusheeFilter());
+}
+
+bool UPushStatics::MatchesTagQuery(const AActor* Actor, const FGameplayTagQuery& Query)
+{
+	if (Query.IsEmpty())
+	{
+		return true;
+	}
+
+	if (!Actor)
+	{
+		return false;
+	}
+
+	if (const UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor))
+	{
+		return AbilitySystem->MatchesGameplayTagQuery(Query);
+	}
+
+	if (const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Actor))
+	{
+		FGameplayTagContainer Tags;
+		TagInterface->GetOwnedGameplayTags(Tags);
+		return Query.Matches(Tags);
+	}
+
+	return false;
+}
+
+void UPushStatics::ApplyPushFilterToBody(AActor* Actor)
+{
+	const IPusherTarget* Pusher = GetPusherTarget(Actor);
+	if (UPrimitiveComponent* Primitive = Pusher ? Cast<UPrimitiveComponent>(Actor->GetRootComponent()) : nullptr)
+	{
+		Primitive->SetMaskFilterOnBodyInstance(Pusher->GetPusherFilter().GetBodyMaskFilter());
+	}
+}
+
 FVector UPushStatics::GetPushPawnAcceleration(const IPusheeInstigator* Pushee)
 {
 	return Pushee ? Pushee->GetPusheeAcceleration().GetSafeNormal() : FVector::ZeroVector;
@@ -542,6 +512,266 @@ float UPushStatics::GetPushPawnScanRange(const FVector& Acceleration, float Base
 	return BaseScanRange * (IsPusheeAccelerating(Acceleration) ? ScanParams.ScanRangeAccelScalar : ScanParams.ScanRangeScalar);
 }
 
+float UPushStatics::GetTimeToContact(const FVector& LocationA, const FVector& VelocityA, float RadiusA,
+	const FVector& LocationB, const FVector& VelocityB, float RadiusB, bool bIs2D)
+{
+	// Solve |Separation + RelativeVelocity * t| = CombinedRadius for the earliest t
+	FVector Separation = LocationB - LocationA;
+	FVector RelativeVelocity = VelocityB - VelocityA;
+	if (bIs2D)
+	{
+		Separation.Z = 0.f;
+		RelativeVelocity.Z = 0.f;
+	}
+
+	const float CombinedRadius = RadiusA + RadiusB;
+	const float C = Separation.SizeSquared() - FMath::Square(CombinedRadius);
+
+	// Already in contact
+	if (C <= 0.f)
+	{
+		return 0.f;
+	}
+
+	// Not closing on each other
+	const float A = RelativeVelocity.SizeSquared();
+	const float B = Separation | RelativeVelocity;
+	if (A <= UE_KINDA_SMALL_NUMBER || B >= 0.f)
+	{
+		return -1.f;
+	}
+
+	// Closest approach doesn't reach contact
+	const float Discriminant = B * B - A * C;
+	if (Discriminant < 0.f)
+	{
+		return -1.f;
+	}
+
+	return (-B - FMath::Sqrt(Discriminant)) / A;
+}
+
+namespace PushPawnNarrowphase
+{
+	/**
+	 * A segment with a radius, spheres have a zero length segment
+	 * Math is done in FVector::FReal, results are narrowed to float once when written out
+	 */
+	struct FSweptSphere
+	{
+		FVector Start;
+		FVector End;
+		FVector::FReal Radius;
+	};
+
+	static FSweptSphere MakeSweptSphere(const FCollisionShape& Shape, const FVector& Location, const FQuat& Rotation)
+	{
+		if (Shape.IsCapsule())
+		{
+			const FVector Axis = Rotation.GetUpVector() * Shape.GetCapsuleAxisHalfLength();
+			return { Location - Axis, Location + Axis, Shape.GetCapsuleRadius() };
+		}
+		return { Location, Location, Shape.GetSphereRadius() };
+	}
+
+	/** @return Closest point on the box to Point, and whether Point was inside the box */
+	static FVector ClosestPointOnBox(const FVector& Point, const FVector& Center, const FQuat& Rotation,
+		const FVector& Extent, bool& bOutInside)
+	{
+		const FVector Local = Rotation.UnrotateVector(Point - Center);
+		const FVector Clamped = Local.BoundToBox(-Extent, Extent);
+		bOutInside = Local == Clamped;
+		return Center + Rotation.RotateVector(Clamped);
+	}
+
+	static bool SweptSphereOverlap(const FSweptSphere& A, const FSweptSphere& B, float& OutDepth, FVector& OutNormal)
+	{
+		FVector PointA, PointB;
+		FMath::SegmentDistToSegmentSafe(A.Start, A.End, B.Start, B.End, PointA, PointB);
+
+		const FVector Delta = PointA - PointB;
+		const FVector::FReal DistSq = Delta.SizeSquared();
+		const FVector::FReal CombinedRadius = A.Radius + B.Radius;
+		if (DistSq > FMath::Square(CombinedRadius))
+		{
+			return false;
+		}
+
+		const FVector::FReal Dist = FMath::Sqrt(DistSq);
+		OutDepth = static_cast<float>(CombinedRadius - Dist);
+		OutNormal = Dist > UE_KINDA_SMALL_NUMBER ? Delta / Dist : FVector::UpVector;
+		return true;
+	}
+
+	static bool SweptSphereBoxOverlap(const FSweptSphere& A, const FVector& BoxCenter, const FQuat& BoxRotation,
+		const FVector& BoxExtent, float& OutDepth, FVector& OutNormal)
+	{
+		// Closest point on the segment to the box, then on the box to that point. Exact for spheres
+		const FVector SegmentPoint = FMath::ClosestPointOnSegment(BoxCenter, A.Start, A.End);
+		bool bInside;
+		const FVector BoxPoint = ClosestPointOnBox(SegmentPoint, BoxCenter, BoxRotation, BoxExtent, bInside);
+		const FVector SweptPoint = FMath::ClosestPointOnSegment(BoxPoint, A.Start, A.End);
+
+		if (bInside)
+		{
+			// Push out along the axis of least penetration
+			const FVector Local = BoxRotation.UnrotateVector(SweptPoint - BoxCenter);
+			const FVector Remaining = BoxExtent - Local.GetAbs();
+			int32 Axis = 0;
+			if (Remaining.Y < Remaining[Axis]) { Axis = 1; }
+			if (Remaining.Z < Remaining[Axis]) { Axis = 2; }
+
+			FVector LocalNormal = FVector::ZeroVector;
+			LocalNormal[Axis] = Local[Axis] >= 0.f ? 1.f : -1.f;
+			OutDepth = static_cast<float>(Remaining[Axis] + A.Radius);
+			OutNormal = BoxRotation.RotateVector(LocalNormal);
+			return true;
+		}
+
+		const FVector Delta = SweptPoint - BoxPoint;
+		const FVector::FReal DistSq = Delta.SizeSquared();
+		if (DistSq > FMath::Square(A.Radius))
+		{
+			return false;
+		}
+
+		const FVector::FReal Dist = FMath::Sqrt(DistSq);
+		OutDepth = static_cast<float>(A.Radius - Dist);
+		OutNormal = Dist > UE_KINDA_SMALL_NUMBER ? Delta / Dist : FVector::UpVector;
+		return true;
+	}
+
+	/** Radius of the shape on X/Y, boxes use their footprint's half diagonal */
+	static float GetRadius2D(const FCollisionShape& Shape)
+	{
+		if (Shape.IsBox())
+		{
+			return FVector2f(Shape.Box.HalfExtentX, Shape.Box.HalfExtentY).Size();
+		}
+		return Shape.IsCapsule() ? Shape.GetCapsuleRadius() : Shape.GetSphereRadius();
+	}
+
+	static float GetHalfHeight(const FCollisionShape& Shape)
+	{
+		if (Shape.IsBox())
+		{
+			return Shape.Box.HalfExtentZ;
+		}
+		return Shape.IsCapsule() ? Shape.GetCapsuleHalfHeight() : Shape.GetSphereRadius();
+	}
+}
+
+float UPushStatics::GetShapeRadius2D(const FCollisionShape& Shape)
+{
+	return PushPawnNarrowphase::GetRadius2D(Shape);
+}
+
+float UPushStatics::GetPusheeRadius2D(const AActor* Actor)
+{
+	if (const IPusheeInstigator* Pushee = GetPusheeInstigator(Actor))
+	{
+		FQuat ShapeRotation;
+		return GetShapeRadius2D(Pushee->GetPusheeCollisionShape(ShapeRotation));
+	}
+	return Actor ? Actor->GetSimpleCollisionRadius() : 0.f;
+}
+
+bool UPushStatics::SupportsAnalyticOverlap(const FCollisionShape& Shape)
+{
+	return (Shape.IsCapsule() || Shape.IsSphere() || Shape.IsBox()) && !Shape.IsNearlyZero();
+}
+
+bool UPushStatics::ComputeShapeOverlap(const FCollisionShape& ShapeA, const FVector& LocationA,
+	const FQuat& RotationA, const FCollisionShape& ShapeB, const FVector& LocationB, const FQuat& RotationB,
+	bool bIs2D, float& OutPenetrationDepth, FVector& OutNormal)
+{
+	using namespace PushPawnNarrowphase;
+
+	// Callers may read the outputs regardless of the result
+	OutPenetrationDepth = 0.f;
+	OutNormal = FVector::ZeroVector;
+
+	if (!SupportsAnalyticOverlap(ShapeA) || !SupportsAnalyticOverlap(ShapeB))
+	{
+		return false;
+	}
+
+	// Circles on X/Y, with a vertical overlap test
+	if (bIs2D)
+	{
+		const FVector Delta = LocationA - LocationB;
+		if (FMath::Abs(Delta.Z) > GetHalfHeight(ShapeA) + GetHalfHeight(ShapeB))
+		{
+			return false;
+		}
+
+		const FVector::FReal DistSq = Delta.SizeSquared2D();
+		const FVector::FReal CombinedRadius = GetRadius2D(ShapeA) + GetRadius2D(ShapeB);
+		if (DistSq > FMath::Square(CombinedRadius))
+		{
+			return false;
+		}
+
+		const FVector::FReal Dist = FMath::Sqrt(DistSq);
+		OutPenetrationDepth = static_cast<float>(CombinedRadius - Dist);
+		OutNormal = Dist > UE_KINDA_SMALL_NUMBER ? FVector(Delta.X, Delta.Y, 0.f) / Dist : FVector::ForwardVector;
+		return true;
+	}
+
+	if (ShapeB.IsBox())
+	{
+		// Box against box, test the bounding sphere of A
+		const FSweptSphere SweptA = ShapeA.IsBox() ?
+			FSweptSphere{ LocationA, LocationA, ShapeA.GetExtent().Size() } : MakeSweptSphere(ShapeA, LocationA, RotationA);
+		return SweptSphereBoxOverlap(SweptA, LocationB, RotationB, ShapeB.GetExtent(), OutPenetrationDepth, OutNormal);
+	}
+
+	if (ShapeA.IsBox())
+	{
+		// Test from B's side, then flip the normal so it still points towards A
+		const bool bOverlap = SweptSphereBoxOverlap(MakeSweptSphere(ShapeB, LocationB, RotationB), LocationA,
+			RotationA, ShapeA.GetExtent(), OutPenetrationDepth, OutNormal);
+		OutNormal = -OutNormal;
+		return bOverlap;
+	}
+
+	return SweptSphereOverlap(MakeSweptSphere(ShapeA, LocationA, RotationA),
+		MakeSweptSphere(ShapeB, LocationB, RotationB), OutPenetrationDepth, OutNormal);
+}
+
+void UPushStatics::ComputeCircleOverlap4(const FVector& Location, float Radius, float HalfHeight,
+	const float* CandidateX, const float* CandidateY, const float* CandidateZ, const float* CandidateRadius,
+	const float* CandidateHalfHeight, float* OutPenetrationDepth)
+{
+	const FVector3f Origin(Location);
+	const VectorRegister4Float X = VectorSetFloat1(Origin.X);
+	const VectorRegister4Float Y = VectorSetFloat1(Origin.Y);
+	const VectorRegister4Float Z = VectorSetFloat1(Origin.Z);
+
+	const VectorRegister4Float DeltaX = VectorSubtract(VectorLoad(CandidateX), X);
+	const VectorRegister4Float DeltaY = VectorSubtract(VectorLoad(CandidateY), Y);
+	const VectorRegister4Float DeltaZ = VectorAbs(VectorSubtract(VectorLoad(CandidateZ), Z));
+
+	const VectorRegister4Float DistSq = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+	const VectorRegister4Float CombinedRadius = VectorAdd(VectorLoad(CandidateRadius), VectorSetFloat1(Radius));
+	const VectorRegister4Float CombinedHalfHeight = VectorAdd(VectorLoad(CandidateHalfHeight), VectorSetFloat1(HalfHeight));
+
+	alignas(16) float DistSqOut[4];
+	alignas(16) float CombinedRadiusOut[4];
+	alignas(16) float VerticalGapOut[4];
+	VectorStoreAligned(DistSq, DistSqOut);
+	VectorStoreAligned(CombinedRadius, CombinedRadiusOut);
+	VectorStoreAligned(VectorSubtract(DeltaZ, CombinedHalfHeight), VerticalGapOut);
+
+	// Only overlapping lanes need the square root
+	for (int32 Lane = 0; Lane < 4; Lane++)
+	{
+		const bool bOverlap = CandidateRadius[Lane] >= 0.f && VerticalGapOut[Lane] <= 0.f &&
+			DistSqOut[Lane] <= FMath::Square(CombinedRadiusOut[Lane]);
+		OutPenetrationDepth[Lane] = bOverlap ? CombinedRadiusOut[Lane] - FMath::Sqrt(DistSqOut[Lane]) : -1.f;
+	}
+}
+
 bool UPushStatics::GatherPushOptions(const TSubclassOf<UGameplayAbility>& PushAbilityToGrant,
 	const APawn* PusherPawn, const FPushQuery& PushQuery, const FPushOptionBuilder& OptionBuilder)
 {
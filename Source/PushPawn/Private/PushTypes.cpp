@@ -18,9 +18,35 @@ FPushPawnScanParams::FPushPawnScanParams()
     , RadiusVelocityScalar(nullptr)
     , ScanRate(0.1f)
     , ScanRateAccel(0.05f)
+	, MinScanInterval(0.02f)
+	, bPredictiveScan(false)
+	, PredictiveScanTimeScalar(1.f)
+	, bTimeToContactScheduling(false)
+	, MaxScanInterval(0.5f)
+	, MaxClosingSpeed(1200.f)
+	, bAllowSleep(false)
+	, SleepDelay(2.f)
+	, SleepWakeCheckRate(0.25f)
+	, bUseNeighborList(false)
+	, NeighborSkin(60.f)
+	, bCentralizedScan(false)
+	, bApplyMaskFilter(false)
+	, OptionLocationTolerance(0.f)
+	, MinPushInterval(0.f)
+	, ContactExitDistance(0.f)
 	, StrengthOverrideHandling(EPushPawnOverrideHandling::Min)
 {}
 
+uint8 FPushPawnFilter::GetBodyMaskFilter() const
+{
+	return static_cast<uint8>(Categories & ((1 << NumExtraFilterBits) - 1));
+}
+
+uint8 FPushPawnFilter::GetQueryIgnoreMask() const
+{
+	return static_cast<uint8>(~CanBePushedByMask & ((1 << NumExtraFilterBits) - 1));
+}
+
 FCollisionShape FPushPawnCollisionShapeHelper::ToCollisionShape() const
 {
 	switch (CollisionType)
@@ -3,10 +3,11 @@
 
 #include "Tasks/AbilityTask_PushPawnForce.h"
 
-#include "GameFramework/CharacterMovementComponent.h"
+#include "PushPawnMovementBackend.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "AbilitySystemLog.h"
+#include "PushPawnStats.h"
 
 #include "TimerManager.h"
 #include "Engine/World.h"
@@ -29,7 +30,7 @@ UAbilityTask_PushPawnForce::UAbilityTask_PushPawnForce(const FObjectInitializer&
 	bIsAdditive = true;
 	bEnableGravity = false;
 
-	RootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+	PushID = INDEX_NONE;
 	bIsFinished = false;
 }
 
@@ -87,36 +88,34 @@ void UAbilityTask_PushPawnForce::InitSimulatedTask(UGameplayTasksComponent& InGa
 
 void UAbilityTask_PushPawnForce::SharedInitAndApply()
 {
+	LLM_SCOPE_BYTAG(PushPawn);
+
 	const UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
-	if (ASC && ASC->AbilityActorInfo->MovementComponent.IsValid())
+	UActorComponent* FoundMovementComponent = nullptr;
+	const UPushPawnMovementBackend* FoundBackend = ASC ?
+		UPushPawnMovementBackend::FindBackend(ASC->GetAvatarActor_Direct(), FoundMovementComponent) : nullptr;
+	if (FoundBackend)
 	{
-		MovementComponent = Cast<UCharacterMovementComponent>(ASC->AbilityActorInfo->MovementComponent.Get());
-
-		if (MovementComponent)
+		MovementComponent = FoundMovementComponent;
+		MovementBackend = FoundBackend;
+
+		FPushPawnForce Force;
+		Force.Force = WorldDirection * Strength;
+		Force.Duration = Duration;
+		Force.StrengthOverTime = StrengthOverTime;
+		Force.bIsAdditive = bIsAdditive;
+		Force.bEnableGravity = bEnableGravity;
+
+		PushID = MovementBackend->ApplyPush(MovementComponent, Force);
+		if (PushID != INDEX_NONE)
+		{
+			const FTimerDelegate TimerDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::EndTask);
+			GetWorld()->GetTimerManager().SetTimer(FinishTimerHandle, TimerDelegate, Duration, false);
+		}
+		else
 		{
-			const TSharedPtr<FRootMotionSource_ConstantForce> ConstantForce = MakeShared<FRootMotionSource_ConstantForce>();
-			ConstantForce->InstanceName = TEXT("PushPawnForce");
-			ConstantForce->AccumulateMode = bIsAdditive ? ERootMotionAccumulateMode::Additive : ERootMotionAccumulateMode::Override;
-			ConstantForce->Priority = 2;  // Low priority for pushing
-			ConstantForce->Force = WorldDirection * Strength;
-			ConstantForce->Duration = Duration;
-			ConstantForce->StrengthOverTime = StrengthOverTime;
-			ConstantForce->FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::MaintainLastRootMotionVelocity;
-			if (bEnableGravity)
-			{
-				ConstantForce->Settings.SetFlag(ERootMotionSourceSettingsFlags::IgnoreZAccumulate);
-			}
-			RootMotionSourceID = MovementComponent->ApplyRootMotionSource(ConstantForce);
-			if (RootMotionSourceID != (uint16)ERootMotionSourceID::Invalid)
-			{
-				const FTimerDelegate TimerDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::EndTask);
-				GetWorld()->GetTimerManager().SetTimer(FinishTimerHandle, TimerDelegate, Duration, false);
-			}
-			else
-			{
-				ABILITY_LOG(Warning, TEXT("UAbilityTask_PushPawnForce failed to apply root motion source; Task Instance Name %s."), *InstanceName.ToString());
-				EndTask();
-			}
+			ABILITY_LOG(Warning, TEXT("UAbilityTask_PushPawnForce failed to apply push force; Task Instance Name %s."), *InstanceName.ToString());
+			EndTask();
 		}
 	}
 	else
@@ -130,20 +129,14 @@ void UAbilityTask_PushPawnForce::SharedInitAndApply()
 
 bool UAbilityTask_PushPawnForce::HasTimedOut() const
 {
-	const TSharedPtr<FRootMotionSource> RMS = (MovementComponent ? MovementComponent->GetRootMotionSourceByID(RootMotionSourceID) : nullptr);
-	if (!RMS.IsValid())
-	{
-		return true;
-	}
-
-	return RMS->Status.HasFlag(ERootMotionSourceStatusFlags::Finished);
+	return !MovementBackend || !MovementBackend->IsPushActive(MovementComponent, PushID);
 }
 
 void UAbilityTask_PushPawnForce::OnDestroy(bool bInOwnerFinished)
 {
-	if (MovementComponent)
+	if (MovementBackend && MovementComponent)
 	{
-		MovementComponent->RemoveRootMotionSourceByID(RootMotionSourceID);
+		MovementBackend->RemovePush(MovementComponent, PushID);
 	}
 
 	// Used to end an ability
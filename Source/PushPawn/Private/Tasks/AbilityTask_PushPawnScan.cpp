@@ -9,11 +9,18 @@
 #include "IPush.h"
 #include "PushStatics.h"
 #include "PushQuery.h"
+#include "PushPawnStats.h"
+#include "PushPawnSubsystem.h"
+#include "PushPawnProfile.h"
+#include "PushPawnSettings.h"
+#include "PushPawnBenchmark.h"
 
 #include "TimerManager.h"
 #include "Curves/CurveFloat.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "Components/PrimitiveComponent.h"
 #include "CollisionShape.h"
 
 #if !UE_BUILD_SHIPPING
@@ -71,8 +78,11 @@ UAbilityTask_PushPawnScan* UAbilityTask_PushPawnScan::PushPawnScan(
 	FGameplayAbilityTargetingLocationInfo StartLocation, const FPushPawnScanParams& ScanParams, float ActivationFailureDelay
 )
 {
+	LLM_SCOPE_BYTAG(PushPawn);
+
 	UAbilityTask_PushPawnScan* MyObj = NewAbilityTask<UAbilityTask_PushPawnScan>(OwningAbility);
-	MyObj->ScanParams = ScanParams;
+	MyObj->OwnedScanParams = MakeUnique<FPushPawnScanParams>(ScanParams);
+	MyObj->ScanParams = MyObj->OwnedScanParams.Get();
 	MyObj->StartLocation = StartLocation;
 	MyObj->PushQuery = PushQuery;
 	MyObj->ActivationFailureDelay = ActivationFailureDelay;
@@ -80,6 +90,53 @@ UAbilityTask_PushPawnScan* UAbilityTask_PushPawnScan::PushPawnScan(
 	return MyObj;
 }
 
+UAbilityTask_PushPawnScan* UAbilityTask_PushPawnScan::PushPawnScanWithProfile(
+	UGameplayAbility* OwningAbility,
+	FPushQuery PushQuery,
+	FGameplayAbilityTargetingLocationInfo StartLocation, const UPushPawnProfile* Profile, float ActivationFailureDelay
+)
+{
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	if (!Profile)
+	{
+		return PushPawnScan(OwningAbility, PushQuery, StartLocation, FPushPawnScanParams(), ActivationFailureDelay);
+	}
+
+	// Read straight from the profile, it is immutable and outlives us
+	UAbilityTask_PushPawnScan* MyObj = NewAbilityTask<UAbilityTask_PushPawnScan>(OwningAbility);
+	MyObj->Profile = Profile;
+	MyObj->ScanParams = &Profile->ScanParams;
+	MyObj->StartLocation = StartLocation;
+	MyObj->PushQuery = PushQuery;
+	MyObj->ActivationFailureDelay = ActivationFailureDelay;
+
+	return MyObj;
+}
+
+void UAbilityTask_PushPawnScan::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	// Our own copy of the params isn't visible to reflection
+	UAbilityTask_PushPawnScan* This = CastChecked<UAbilityTask_PushPawnScan>(InThis);
+	if (This->OwnedScanParams.IsValid())
+	{
+		Collector.AddReferencedObject(This->OwnedScanParams->RadiusVelocityScalar, This);
+	}
+}
+
+void UAbilityTask_PushPawnScan::AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const
+{
+	Super::AccumulateMemoryUsage(Usage);
+
+	Usage.Caches += Neighbors.GetAllocatedSize() + SyncPoints.GetAllocatedSize();
+	if (OwnedScanParams.IsValid())
+	{
+		Usage.Caches += sizeof(FPushPawnScanParams);
+	}
+}
+
 void UAbilityTask_PushPawnScan::OnNetSync(UAbilityTask_PushPawnSync* SyncPoint)
 {
 	// Remove finished net sync
@@ -92,9 +149,122 @@ void UAbilityTask_PushPawnScan::OnNetSync(UAbilityTask_PushPawnSync* SyncPoint)
 	ActivateTimer();
 }
 
+void UAbilityTask_PushPawnScan::OnClientDeferralSignal(UAbilityTask_PushPawnSync* SyncPoint)
+{
+	if (IsValid(SyncPoint))
+	{
+		SyncPoints.RemoveSingle(SyncPoint);
+	}
+	bWaitingForClientSync = false;
+
+	// Make sure we agree with the client, it has gone a while without pushing, its pushes are verified as they arrive
+	BeginFallbackScan(GetDefault<UPushPawnSettings>()->FallbackScanDuration);
+}
+
+void UAbilityTask_PushPawnScan::BeginFallbackScan(float Duration)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FallbackScanEndTime = FMath::Max(FallbackScanEndTime, World->GetTimeSeconds() + Duration);
+
+	if (bDeferredToClient)
+	{
+		INC_DWORD_STAT(STAT_PushPawn_FallbackScans);
+#if !UE_BUILD_SHIPPING
+		if (FPushPawnBenchCounters* BenchCounters = FPushPawnBenchmark::GetCounters(this))
+		{
+			BenchCounters->FallbackScans++;
+		}
+#endif
+
+		bDeferredToClient = false;
+		ActivateTimer();
+	}
+}
+
+float UAbilityTask_PushPawnScan::GetMaxContactDistance(const AActor* Pusher) const
+{
+	const float ScanRadius = UPushStatics::GetPusheeRadius2D(GetAvatarActor()) * GetMaxShapeScalar();
+	return ScanRadius + UPushStatics::GetPusheeRadius2D(Pusher) + ScanParams->ContactExitDistance;
+}
+
+void UAbilityTask_PushPawnScan::RegisterWithSubsystem(AActor* AvatarActor, const UWorld* World)
+{
+	if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+	{
+		Subsystem->RegisterScan(AvatarActor, this);
+		bRegistered = true;
+	}
+	LastActiveTime = World->GetTimeSeconds();
+
+	// Other scans can only skip our body in physics once it carries our categories
+	if (ScanParams->bApplyMaskFilter)
+	{
+		UPushStatics::ApplyPushFilterToBody(AvatarActor);
+	}
+}
+
+bool UAbilityTask_PushPawnScan::ShouldDeferToClient() const
+{
+	if (!GetDefault<UPushPawnSettings>()->bVerifyClientPushes)
+	{
+		return false;
+	}
+
+	// Only the server defers, and only for pawns a remote client is scanning for
+	const FGameplayAbilityActorInfo* ActorInfo = Ability ? Ability->GetCurrentActorInfo() : nullptr;
+	if (!ActorInfo || !ActorInfo->IsNetAuthority() || ActorInfo->IsLocallyControlled())
+	{
+		return false;
+	}
+
+	const UWorld* World = GetWorld();
+	return World && World->GetTimeSeconds() >= FallbackScanEndTime;
+}
+
+void UAbilityTask_PushPawnScan::DeferToClient()
+{
+	bDeferredToClient = true;
+
+	// Nothing to push us with, the client no longer has our push options either
+	CurrentOptions.Reset();
+
+	// Scan for ourselves whenever the client signals it went a while without pushing, on its own event so the regular
+	// net syncs are left alone
+	if (!bWaitingForClientSync)
+	{
+		bWaitingForClientSync = true;
+
+		UAbilityTask_PushPawnSync* WaitSignal = UAbilityTask_PushPawnSync::WaitNetSync(Ability,
+			GetDefault<UPushPawnSettings>()->DeferralSignalEvent);
+		WaitSignal->OnSync.AddDynamic(this, &ThisClass::OnClientDeferralSignal);
+		WaitSignal->ReadyForActivation();
+		SyncPoints.Add(WaitSignal);
+	}
+}
+
+void UAbilityTask_PushPawnScan::SignalDeferral()
+{
+	const UPushPawnSettings* Settings = GetDefault<UPushPawnSettings>();
+	const FGameplayAbilityActorInfo* ActorInfo = Ability ? Ability->GetCurrentActorInfo() : nullptr;
+	if (!Settings->bVerifyClientPushes || !ActorInfo || ActorInfo->IsNetAuthority())
+	{
+		return;
+	}
+
+	// Sends the signal and finishes immediately, there is nothing to wait for on our end
+	UAbilityTask_PushPawnSync* Signal = UAbilityTask_PushPawnSync::WaitNetSync(Ability, Settings->DeferralSignalEvent);
+	Signal->ReadyForActivation();
+}
+
 void UAbilityTask_PushPawnScan::ActivateTimer(EPushPawnPauseType PauseType)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::ActivateTimer);
+	LLM_SCOPE_BYTAG(PushPawn);
 
 	// Wait for net sync if necessary, this prevents the ability from activating until the server has caught up
 	if (PushScanAbility && PushScanAbility->ShouldWaitForNetSync())
@@ -107,9 +277,15 @@ void UAbilityTask_PushPawnScan::ActivateTimer(EPushPawnPauseType PauseType)
 		}
 
 		// Consumes the wait for net sync
+		const bool bSyncWithoutPush = PushScanAbility->TriggeredPushesSinceLastNetSync == 0;
 		PushScanAbility->ConsumeWaitForNetSync();
 
 #if !UE_BUILD_SHIPPING
+		if (FPushPawnBenchCounters* BenchCounters = FPushPawnBenchmark::GetCounters(this))
+		{
+			BenchCounters->NetSyncs++;
+		}
+
 		// Print to screen if desired
 		if (FPushPawnCVars::PushPawnPrintNetSync > 0)
 		{
@@ -132,6 +308,12 @@ void UAbilityTask_PushPawnScan::ActivateTimer(EPushPawnPauseType PauseType)
 		WaitNetSync->OnSync.AddDynamic(this, &ThisClass::OnNetSync);
 		WaitNetSync->ReadyForActivation();
 		SyncPoints.Add(WaitNetSync);
+
+		// Our pushes are verified as they arrive, a server deferring to us only needs to check when we haven't pushed
+		if (bSyncWithoutPush)
+		{
+			SignalDeferral();
+		}
 		return;
 	}
 
@@ -142,7 +324,14 @@ void UAbilityTask_PushPawnScan::ActivateTimer(EPushPawnPauseType PauseType)
 			OnPushPawnScanPauseStateChangedDelegate = Pushee->GetPushPawnScanPausedDelegate();
 			if (OnPushPawnScanPauseStateChangedDelegate)
 			{
-				OnPushPawnScanPauseStateChangedDelegate->BindUObject(this, &ThisClass::OnScanPaused);
+				OnPushPawnScanPauseStateChangedDelegate->BindUObject(this, &ThisClass::OnExternalScanPaused);
+
+				// Start paused if requested, e.g. no neighbors are inside the overlap sensor
+				if (Pushee->IsPushPawnScanPaused())
+				{
+					OnExternalScanPaused(true);
+					return;
+				}
 			}
 		}
 	}
@@ -152,15 +341,40 @@ void UAbilityTask_PushPawnScan::ActivateTimer(EPushPawnPauseType PauseType)
 	{
 		if (Ability)
 		{
-			float ScanRate = ScanParams.ScanRate;
+			float ScanRate = ScanParams->ScanRate;
 			if (!IsWaitingOnAvatar() && GetAvatarActor())
 			{
 				if (APawn* Pawn = Cast<APawn>(GetAvatarActor()))
 				{
-					ScanRate = UPushStatics::GetPushPawnScanRate(Pawn, ScanParams);
+					ScanRate = UPushStatics::GetPushPawnScanRate(Pawn, *ScanParams);
 				}
 			}
+
+			// Scan again when the nearest candidate is expected to reach us
+			if (ScanParams->bTimeToContactScheduling && TimeToContactInterval > 0.f)
+			{
+				ScanRate = TimeToContactInterval;
+			}
+
+			// A predicted contact occurs before the next scan, bring the scan forward to the time of impact
+			if (PredictedTimeOfImpact >= 0.f)
+			{
+				ScanRate = FMath::Clamp(PredictedTimeOfImpact, ScanParams->MinScanInterval, ScanRate);
+				PredictedTimeOfImpact = -1.f;
+			}
+
 			this->CurrentScanRate = ScanRate;
+
+			// Centralized scans are run by the subsystem's tick functions after movement, instead of a timer
+			if (ScanParams->bCentralizedScan)
+			{
+				if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+				{
+					Subsystem->ScheduleScan(this, ScanRate);
+					return;
+				}
+			}
+
 			GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &ThisClass::PerformTrace, ScanRate, false);	
 		}
 	};
@@ -202,6 +416,26 @@ void UAbilityTask_PushPawnScan::OnDestroy(bool bInOwnerFinished)
 		GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
 	}
 
+	// Remove from the schedule and registry
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this);
+	if (Subsystem)
+	{
+		Subsystem->UnscheduleScan(this);
+	}
+	if (bRegistered)
+	{
+		if (Subsystem)
+		{
+			if (bSleeping)
+			{
+				Subsystem->SetScanSleeping(false);
+			}
+			Subsystem->UnregisterScan(GetAvatarActor(), this);
+		}
+		bRegistered = false;
+	}
+	bSleeping = false;
+
 	// Unbind the delegate
 	if (OnPushPawnScanPauseStateChangedDelegate)
 	{
@@ -224,6 +458,19 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::PerformTrace);
 
+	FPushPawnScanContext Context;
+	if (PrepareScan(Context))
+	{
+		ExecuteScan(Context);
+		CommitScan(Context);
+	}
+}
+
+bool UAbilityTask_PushPawnScan::PrepareScan(FPushPawnScanContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::PrepareScan);
+	INC_DWORD_STAT(STAT_PushPawn_Scans);
+
 #if !UE_BUILD_SHIPPING
 	if (FPushPawnCVars::bPushPawnDisabled)
 	{
@@ -244,7 +491,7 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 			}
 		});
 		FPushPawnCVars::CVarPushPawnDisabled->SetOnChangedCallback(OnDisabledDelegate);
-		return;
+		return false;
 	}
 #endif
 	
@@ -253,7 +500,7 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 	if (!AvatarActor)
 	{
 		ActivateTimer(EPushPawnPauseType::ActivationFailed);
-		return;
+		return false;
 	}
 
 	// Check if we have a world
@@ -261,14 +508,27 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 	if (!World)
 	{
 		ActivateTimer(EPushPawnPauseType::ActivationFailed);
-		return;
+		return false;
 	}
 
 	// This can realistically occur before initialization passes
 	if (!AvatarActor->HasActorBegunPlay())
 	{
 		ActivateTimer(EPushPawnPauseType::ActivationFailed);
-		return;
+		return false;
+	}
+
+	// Register so nearby pushers can find and wake us
+	if (!bRegistered)
+	{
+		RegisterWithSubsystem(AvatarActor, World);
+	}
+
+	// The owning client scans for us, we only verify what it predicts
+	if (ShouldDeferToClient())
+	{
+		DeferToClient();
+		return false;
 	}
 
 	const IPusheeInstigator* Pushee = UPushStatics::GetPusheeInstigator(AvatarActor);
@@ -283,33 +543,54 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 #else
 		ABILITY_LOG(Error, TEXT("%s"), *ErrorString);
 #endif
-        return;
+        return false;
     }
 
+	// Read our state from the snapshot when available, instead of calling through the interface
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this);
+	FPushPawnSnapshot* Snapshot = Subsystem ? &Subsystem->GetSnapshot() : nullptr;
+	const int32 SnapshotIndex = Snapshot ? Snapshot->FindOrCapture(AvatarActor) : INDEX_NONE;
+	const bool bUseSnapshot = SnapshotIndex != INDEX_NONE;
+
+	const FVector Velocity = bUseSnapshot ? Snapshot->Velocities[SnapshotIndex] : Pushee->GetPusheeVelocity();
+	const FVector Acceleration = bUseSnapshot ? Snapshot->Accelerations[SnapshotIndex] : UPushStatics::GetPushPawnAcceleration(Pushee);
+
 	// If we don't have a valid collision shape, we can't scan
 	FQuat ShapeRotation;
-	FCollisionShape CollisionShape = Pushee->GetPusheeCollisionShape(ShapeRotation);
+	FCollisionShape CollisionShape;
+	if (bUseSnapshot)
+	{
+		CollisionShape = Snapshot->Shapes[SnapshotIndex];
+		ShapeRotation = Snapshot->ShapeRotations[SnapshotIndex];
+	}
+	else
+	{
+		CollisionShape = Pushee->GetPusheeCollisionShape(ShapeRotation);
+	}
 	const bool bValidShape = !CollisionShape.IsLine() && !CollisionShape.IsNearlyZero();
 	if (!ensureMsgf(bValidShape, TEXT("PushPawn: Pushee %s has an invalid collision shape!"), *AvatarActor->GetName()))
     {
         ActivateTimer(EPushPawnPauseType::ActivationFailed);
-        return;
+        return false;
     }
 
 	// Increase the collision size based on the pushee's speed and acceleration
 	float VelocityScalar = 1.f;
 	
 	// Check if the pushee is accelerating
-	const bool bHasAcceleration = UPushStatics::IsPusheeAccelerating(Pushee);
+	const bool bHasAcceleration = UPushStatics::IsPusheeAccelerating(Acceleration);
 
 	// Get the velocity scalar from the curve
-	if (ScanParams.RadiusVelocityScalar)
+	if (ScanParams->RadiusVelocityScalar)
 	{
-		VelocityScalar = ScanParams.RadiusVelocityScalar->GetFloatValue(UPushStatics::GetPusheeGroundSpeed(Pushee));
+		const float GroundSpeed = bUseSnapshot ? Snapshot->GetGroundVelocity(SnapshotIndex).Size() :
+			UPushStatics::GetPusheeGroundSpeed(Pushee);
+		VelocityScalar = Profile ? Profile->RadiusVelocityScalarLUT.Evaluate(GroundSpeed, ScanParams->RadiusVelocityScalar) :
+			ScanParams->RadiusVelocityScalar->GetFloatValue(GroundSpeed);
 	}
 
 	// Calculate the radius scalar
-	const float RadiusScalar = bHasAcceleration ? ScanParams.PusheeRadiusAccelScalar : ScanParams.PusheeRadiusScalar;
+	const float RadiusScalar = bHasAcceleration ? ScanParams->PusheeRadiusAccelScalar : ScanParams->PusheeRadiusScalar;
 
 	// Create a collision shape to trace with
 	const float ShapeScalar = RadiusScalar * VelocityScalar;
@@ -334,25 +615,207 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 		default: break;
 	}
 
-	// Initialize trace params
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(AvatarActor);
-	
+	Context.AvatarActor = AvatarActor;
+	Context.Location = StartLocation.GetTargetingTransform().GetLocation();
+	Context.TraceEnd = Context.Location;
+	Context.Velocity = Velocity;
+	Context.Acceleration = Acceleration;
+	Context.bHasAcceleration = bHasAcceleration;
+	Context.Shape = CollisionShape;
+	Context.ShapeRotation = ShapeRotation;
+	Context.ShapeScalar = ShapeScalar;
+	Context.SnapshotIndex = SnapshotIndex;
+
+	PredictedTimeOfImpact = -1.f;
+	return true;
+}
+
+void UAbilityTask_PushPawnScan::ExecuteScan(FPushPawnScanContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::ExecuteScan);
+
+	const UWorld* World = GetWorld();
+	const FCollisionShape& CollisionShape = Context.Shape;
+	const FQuat& ShapeRotation = Context.ShapeRotation;
+	const FCollisionQueryParams Params = MakeQueryParams(Context.AvatarActor);
+
+	// Perform the trace
+	const FVector& TraceStart = Context.Location;
+	FVector& TraceEnd = Context.TraceEnd;
+	FHitResult& Hit = Context.Hit;
+
+	// Sweep along our velocity for the duration of the next scan interval
+	float SweepDuration = 0.f;
+	if (ScanParams->bPredictiveScan)
+	{
+		SweepDuration = UPushStatics::GetPushPawnScanRate(Context.Acceleration, *ScanParams) * ScanParams->PredictiveScanTimeScalar;
+		TraceEnd = TraceStart + Context.Velocity * SweepDuration;
+	}
+
+	if (!TraceEnd.Equals(TraceStart, 1.f))
+	{
+		ShapeSweep(Hit, World, TraceStart, TraceEnd, ShapeRotation, ScanParams->TraceChannel, Params, CollisionShape);
+
+		// Contact is ahead of us, report it and scan again at the time of impact
+		if (Hit.GetActor() && !Hit.bStartPenetrating && Hit.Time > 0.f)
+		{
+			PredictedContact = Hit;
+			PredictedTimeOfImpact = Hit.Time * SweepDuration;
+		}
+	}
+	else if (ScanParams->bUseNeighborList || ScanParams->bTimeToContactScheduling)
+	{
+		// Only trace when the cached candidates may be stale
+		if (ShouldRebuildNeighbors(TraceStart))
+		{
+			RebuildNeighbors(World, TraceStart, ShapeRotation, CollisionShape, Context.ShapeScalar, Params);
+		}
+		QueryNeighbors(Hit, TraceStart, ShapeRotation, CollisionShape);
+	}
+	else
+	{
+		ShapeTrace(Hit, World, TraceStart, ShapeRotation, ScanParams->TraceChannel, Params, CollisionShape);
+	}
+}
+
+void UAbilityTask_PushPawnScan::ExecuteCentralizedScan(FPushPawnScanContext& Context,
+	const FPushPawnSnapshot& Snapshot, const FPushPawnGrid& Grid) const
+{
+	// May run on any thread, only the snapshot and grid can be read here
+
+	// Contact is measured against our scaled scan shape, the same shape that finds push options
+	const bool bTimeToContact = ScanParams->bTimeToContactScheduling;
+	const float Radius = bTimeToContact ? UPushStatics::GetShapeRadius2D(Context.Shape) : 0.f;
+
+	float DeepestDepth = -1.f;
+	Grid.ForEachCandidate(Context.Location, [&](int32 CandidateIndex)
+	{
+		if (CandidateIndex == Context.SnapshotIndex || !Snapshot.HasFlag(CandidateIndex, EPushPawnSnapshotFlags::PushCapable))
+		{
+			return;
+		}
+
+		// Reject by category before the narrowphase
+		if (Context.SnapshotIndex != INDEX_NONE && !Snapshot.PassesPushFilter(CandidateIndex, Context.SnapshotIndex))
+		{
+			return;
+		}
+
+		// The grid covers anything that can reach us over MaxScanInterval, see UPushPawnSubsystem::PrepareScans()
+		if (bTimeToContact)
+		{
+			const float CandidateTimeToContact = UPushStatics::GetTimeToContact(Context.Location, Context.Velocity, Radius,
+				Snapshot.Locations[CandidateIndex], Snapshot.Velocities[CandidateIndex],
+				UPushStatics::GetShapeRadius2D(Snapshot.Shapes[CandidateIndex]), ScanParams->bDirectionIs2D);
+			if (CandidateTimeToContact >= 0.f && CandidateTimeToContact <= ScanParams->MaxScanInterval)
+			{
+				Context.ClosingIndices.Add(CandidateIndex);
+				Context.TimeToContact = Context.TimeToContact < 0.f ? CandidateTimeToContact :
+					FMath::Min(Context.TimeToContact, CandidateTimeToContact);
+			}
+		}
+
+		float Depth;
+		FVector Normal;
+		if (UPushStatics::ComputeShapeOverlap(Context.Shape, Context.Location, Context.ShapeRotation,
+			Snapshot.Shapes[CandidateIndex], Snapshot.Locations[CandidateIndex], Snapshot.ShapeRotations[CandidateIndex],
+			ScanParams->bDirectionIs2D, Depth, Normal) && Depth > DeepestDepth)
+		{
+			DeepestDepth = Depth;
+			Context.CandidateIndex = CandidateIndex;
+			Context.Hit.Normal = Normal;
+			Context.Hit.ImpactNormal = Normal;
+			Context.Hit.PenetrationDepth = Depth;
+		}
+	});
+
+	Context.Hit.TraceStart = Context.Location;
+	Context.Hit.TraceEnd = Context.Location;
+	Context.Hit.Location = Context.Location;
+}
+
+FCollisionQueryParams UAbilityTask_PushPawnScan::MakeQueryParams(const AActor* AvatarActor) const
+{
 	constexpr bool bTraceComplex = false;
 	FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_PushPawnScan_Trace), bTraceComplex);
-	Params.AddIgnoredActors(ActorsToIgnore);
+	Params.AddIgnoredActor(AvatarActor);
 
-	// Perform the trace
-	const FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
-	FHitResult Hit;
-	ShapeTrace(Hit, GetWorld(), TraceStart, ShapeRotation, ScanParams.TraceChannel, Params, CollisionShape);
+	// Skip bodies whose categories can't push us in physics, instead of after the trace
+	if (ScanParams->bApplyMaskFilter)
+	{
+		if (const IPusheeInstigator* Pushee = UPushStatics::GetPusheeInstigator(AvatarActor))
+		{
+			Params.IgnoreMask = Pushee->GetPusheeFilter().GetQueryIgnoreMask();
+		}
+	}
+	return Params;
+}
+
+void UAbilityTask_PushPawnScan::CommitScan(FPushPawnScanContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::CommitScan);
+	LLM_SCOPE_BYTAG(PushPawn);
 
-	// Append the push targets
+	UWorld* World = GetWorld();
+	if (!World || !IsValid(Context.AvatarActor))
+	{
+		ActivateTimer(EPushPawnPauseType::ActivationFailed);
+		return;
+	}
+
+	AActor* AvatarActor = Context.AvatarActor;
+	const FCollisionShape& CollisionShape = Context.Shape;
+	const FQuat& ShapeRotation = Context.ShapeRotation;
+	const FVector& TraceStart = Context.Location;
+	const FVector& TraceEnd = Context.TraceEnd;
+
+	// The centralized read phase can't touch UObjects, fill in the candidate now
+	if (AActor* Candidate = Context.CandidateActor.Get())
+	{
+		Context.Hit.HitObjectHandle = FActorInstanceHandle(Candidate);
+		Context.Hit.Component = Cast<UPrimitiveComponent>(Candidate->GetRootComponent());
+		Context.Hit.ImpactPoint = Candidate->GetActorLocation();
+		Context.Hit.bBlockingHit = true;
+		Context.Hit.bStartPenetrating = true;
+	}
+	const FHitResult& Hit = Context.Hit;
+
+	// Append the push targets, a predicted contact isn't pushed until it occurs
 	TArray<TScriptInterface<IPusherTarget>> PushTargets;
-	UPushStatics::AppendPushTargetsFromHitResult(Hit, PushTargets);
+	if (PredictedTimeOfImpact < 0.f)
+	{
+		UPushStatics::AppendPushTargetsFromHitResult(Hit, PushTargets);
+	}
+
+	// Don't drop a contact the moment it leaves the scan range, wait for it to leave the exit band
+	if (ScanParams->ContactExitDistance > 0.f && CurrentOptions.Num() > 0)
+	{
+		HoldExitingContacts(Context, PushTargets);
+	}
+
+	// Reject by category and rules before gathering any push options
+	if (PushTargets.Num() > 0)
+	{
+		const IPusheeInstigator* Pushee = UPushStatics::GetPusheeInstigator(AvatarActor);
+		UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this);
+		PushTargets.RemoveAllSwap([Pushee, Subsystem, AvatarActor](const TScriptInterface<IPusherTarget>& PushTarget)
+		{
+			return !UPushStatics::PassesPushFilter(PushTarget.GetInterface(), Pushee) ||
+				(Subsystem && !Subsystem->PassesPushRules(UPushStatics::GetActorFromPushTarget(PushTarget), AvatarActor));
+		});
+	}
 
 	// Update the push options
-	UpdatePushOptions(PushQuery, PushTargets);
+	UpdatePushOptions(PushQuery, PushTargets, ScanParams->OptionLocationTolerance);
+
+	// Anyone we found needs to be awake to be pushed by us in turn
+	WakePushTargets(PushTargets);
+
+	// Schedule the next scan for when the nearest candidate can reach us
+	if (ScanParams->bTimeToContactScheduling)
+	{
+		UpdateTimeToContact(Context);
+	}
 
 #if UE_ENABLE_DEBUG_DRAWING
 	if (FPushPawnCVars::PushPawnScanDebugDraw)
@@ -383,13 +846,518 @@ void UAbilityTask_PushPawnScan::PerformTrace()
 		{
 			DrawDebugSphere(World, Hit.Location, 5, 16, DebugColor, false, CurrentScanRate);
 		}
+
+		// Predictive sweep and the location of the predicted contact
+		if (TraceEnd != TraceStart)
+		{
+			DrawDebugLine(World, TraceStart, TraceEnd, FColor::Cyan, false, CurrentScanRate);
+			if (PredictedTimeOfImpact >= 0.f)
+			{
+				DrawDebugSphere(World, PredictedContact.Location, 5, 16, FColor::Yellow, false, CurrentScanRate);
+			}
+		}
 	}
 #endif
 
+	// Sleep if we've been stationary and uncontested for long enough
+	if (ScanParams->bAllowSleep)
+	{
+		const bool bIsActive = CurrentOptions.Num() > 0 || !Context.Velocity.IsNearlyZero() || Context.bHasAcceleration;
+
+		if (bIsActive)
+		{
+			LastActiveTime = World->GetTimeSeconds();
+		}
+		else if (World->TimeSince(LastActiveTime) >= ScanParams->SleepDelay)
+		{
+			Sleep();
+			return;
+		}
+	}
+
 	// Loop the timer
 	ActivateTimer();
 }
 
+void UAbilityTask_PushPawnScan::WakePushTargets(const TArray<TScriptInterface<IPusherTarget>>& PushTargets) const
+{
+	if (PushTargets.Num() == 0)
+	{
+		return;
+	}
+
+	if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+	{
+		for (const TScriptInterface<IPusherTarget>& PushTarget : PushTargets)
+		{
+			Subsystem->WakeScan(UPushStatics::GetActorFromPushTarget(PushTarget));
+		}
+	}
+}
+
+void UAbilityTask_PushPawnScan::HoldExitingContacts(const FPushPawnScanContext& Context,
+	TArray<TScriptInterface<IPusherTarget>>& PushTargets) const
+{
+	const float ScanRadius = UPushStatics::GetShapeRadius2D(Context.Shape);
+
+	for (const FPushOption& Option : CurrentOptions)
+	{
+		if (!Option.PusherTarget.GetObject() || PushTargets.Contains(Option.PusherTarget))
+		{
+			continue;
+		}
+
+		const AActor* PusherActor = UPushStatics::GetActorFromPushTarget(Option.PusherTarget);
+		if (!IsValid(PusherActor))
+		{
+			continue;
+		}
+
+		// Gap between our scan shape and the pusher's collision shape, zero is where the scan stopped finding them
+		const float PusherRadius = UPushStatics::GetPusheeRadius2D(PusherActor);
+		const FVector Delta = PusherActor->GetActorLocation() - Context.Location;
+		const float Distance = ScanParams->bDirectionIs2D ? Delta.Size2D() : Delta.Size();
+		const float Gap = Distance - ScanRadius - PusherRadius;
+		if (Gap <= ScanParams->ContactExitDistance)
+		{
+			INC_DWORD_STAT(STAT_PushPawn_ContactsHeld);
+			PushTargets.Add(Option.PusherTarget);
+		}
+	}
+}
+
+void UAbilityTask_PushPawnScan::Sleep()
+{
+	if (bSleeping || !GetWorld())
+	{
+		return;
+	}
+
+	bSleeping = true;
+	if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+	{
+		Subsystem->SetScanSleeping(true);
+	}
+
+	// Clears our timers and pauses the task
+	OnScanPaused(true);
+
+	// Cheaply poll movement, we don't trace until we wake
+	GetWorld()->GetTimerManager().SetTimer(SleepTimerHandle, this, &ThisClass::CheckWake, ScanParams->SleepWakeCheckRate, true);
+}
+
+void UAbilityTask_PushPawnScan::CheckWake()
+{
+	const IPusheeInstigator* Pushee = UPushStatics::GetPusheeInstigator(GetAvatarActor());
+	if (!Pushee || !Pushee->GetPusheeVelocity().IsNearlyZero() || UPushStatics::IsPusheeAccelerating(Pushee))
+	{
+		WakeUp();
+	}
+}
+
+void UAbilityTask_PushPawnScan::WakeUp()
+{
+	if (!bSleeping)
+	{
+		return;
+	}
+
+	bSleeping = false;
+	if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+	{
+		Subsystem->SetScanSleeping(false);
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(SleepTimerHandle);
+		LastActiveTime = World->GetTimeSeconds();
+	}
+
+	// Remain paused if someone else paused us
+	if (!bScanPausedExternally)
+	{
+		OnScanPaused(false);
+	}
+}
+
+void UAbilityTask_PushPawnScan::OnExternalScanPaused(bool bIsPaused)
+{
+	bScanPausedExternally = bIsPaused;
+
+	// Resuming externally also ends any sleep, the sleep timer was cleared when we paused
+	if (!bIsPaused && bSleeping)
+	{
+		bSleeping = false;
+		if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+		{
+			Subsystem->SetScanSleeping(false);
+		}
+		if (UWorld* World = GetWorld())
+		{
+			LastActiveTime = World->GetTimeSeconds();
+		}
+	}
+
+	OnScanPaused(bIsPaused);
+}
+
+bool UAbilityTask_PushPawnScan::ShouldRebuildNeighbors(const FVector& Location) const
+{
+	if (!bHasNeighborList)
+	{
+		return true;
+	}
+
+	const float NeighborSkin = GetNeighborSkin();
+	const float RebuildDistSq = FMath::Square(NeighborSkin * 0.5f);
+	if (FVector::DistSquared(Location, NeighborListLocation) > RebuildDistSq)
+	{
+		return true;
+	}
+
+	// Pawns outside the list can close on us even while we and every neighbor are stationary
+	const float TimeSinceRebuild = GetWorld()->GetTimeSeconds() - NeighborListTime;
+	if (TimeSinceRebuild * ScanParams->MaxClosingSpeed > NeighborSkin)
+	{
+		return true;
+	}
+
+	for (const FPushPawnNeighbor& Neighbor : Neighbors)
+	{
+		const AActor* NeighborActor = Neighbor.Actor.Get();
+		if (!NeighborActor || FVector::DistSquared(NeighborActor->GetActorLocation(), Neighbor.Location) > RebuildDistSq)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UAbilityTask_PushPawnScan::RebuildNeighbors(const UWorld* World, const FVector& Location, const FQuat& Rotation,
+	const FCollisionShape& Shape, float ShapeScalar, const FCollisionQueryParams& Params)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::RebuildNeighbors);
+	LLM_SCOPE_BYTAG(PushPawn);
+
+	// Grow the scan shape to the largest our speed and acceleration can scale it to, then inflate it by the skin
+	const float NeighborSkin = GetNeighborSkin();
+	const float Growth = ShapeScalar > UE_KINDA_SMALL_NUMBER ? FMath::Max(1.f, GetMaxShapeScalar() / ShapeScalar) : 1.f;
+	FCollisionShape SkinShape = Shape;
+	switch (SkinShape.ShapeType)
+	{
+		case ECollisionShape::Box:
+		{
+			SkinShape.Box.HalfExtentX = SkinShape.Box.HalfExtentX * Growth + NeighborSkin;
+			SkinShape.Box.HalfExtentY = SkinShape.Box.HalfExtentY * Growth + NeighborSkin;
+			SkinShape.Box.HalfExtentZ += NeighborSkin;
+		}
+		break;
+		case ECollisionShape::Sphere:
+		{
+			SkinShape.Sphere.Radius = SkinShape.Sphere.Radius * Growth + NeighborSkin;
+		}
+		break;
+		case ECollisionShape::Capsule:
+		{
+			SkinShape.Capsule.Radius = SkinShape.Capsule.Radius * Growth + NeighborSkin;
+			SkinShape.Capsule.HalfHeight += NeighborSkin;
+		}
+		break;
+		default: break;
+	}
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByChannel(Overlaps, Location, Rotation, ScanParams->TraceChannel, SkinShape, Params);
+
+	// Categories and rules are only re-evaluated when the list is rebuilt
+	const IPusheeInstigator* Pushee = UPushStatics::GetPusheeInstigator(GetAvatarActor());
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this);
+
+	Neighbors.Reset();
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* Candidate = Overlap.GetActor();
+		const IPusherTarget* CandidatePusher = UPushStatics::GetPusherTarget(Candidate);
+		if (!CandidatePusher || !UPushStatics::PassesPushFilter(CandidatePusher, Pushee))
+		{
+			continue;
+		}
+		if (Subsystem && !Subsystem->PassesPushRules(Candidate, GetAvatarActor()))
+		{
+			continue;
+		}
+
+		// Multiple components of the same actor may overlap
+		if (Neighbors.ContainsByPredicate([Candidate](const FPushPawnNeighbor& Neighbor) { return Neighbor.Actor == Candidate; }))
+		{
+			continue;
+		}
+
+		FPushPawnNeighbor& Neighbor = Neighbors.AddDefaulted_GetRef();
+		Neighbor.Actor = Candidate;
+		Neighbor.Component = Overlap.GetComponent();
+		Neighbor.Location = Candidate->GetActorLocation();
+
+		// Pushees with a simple shape can be tested analytically, otherwise we fall back to physics
+		if (const IPusheeInstigator* CandidatePushee = UPushStatics::GetPusheeInstigator(Candidate))
+		{
+			FQuat CandidateShapeRotation;
+			Neighbor.Shape = CandidatePushee->GetPusheeCollisionShape(CandidateShapeRotation);
+			Neighbor.ShapeRotation = Candidate->GetActorQuat().Inverse() * CandidateShapeRotation;
+			Neighbor.bAnalytic = UPushStatics::SupportsAnalyticOverlap(Neighbor.Shape);
+		}
+	}
+
+	NeighborListLocation = Location;
+	NeighborListTime = World->GetTimeSeconds();
+	bHasNeighborList = true;
+}
+
+float UAbilityTask_PushPawnScan::GetMaxShapeScalar() const
+{
+	float MaxVelocityScalar = 1.f;
+	if (ScanParams->RadiusVelocityScalar)
+	{
+		float MinVelocityScalar;
+		ScanParams->RadiusVelocityScalar->GetValueRange(MinVelocityScalar, MaxVelocityScalar);
+	}
+	return FMath::Max(ScanParams->PusheeRadiusScalar, ScanParams->PusheeRadiusAccelScalar) * MaxVelocityScalar;
+}
+
+void UAbilityTask_PushPawnScan::QueryNeighbors(FHitResult& OutHitResult, const FVector& Location,
+	const FQuat& Rotation, const FCollisionShape& Shape) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::QueryNeighbors);
+
+	OutHitResult = FHitResult();
+	OutHitResult.TraceStart = Location;
+	OutHitResult.TraceEnd = Location;
+
+	// Find the neighbor we penetrate the deepest
+	float DeepestDepth = -1.f;
+	const AActor* DeepestActor = nullptr;
+	FVector DeepestLocation = FVector::ZeroVector;
+	FVector DeepestNormal = FVector::ZeroVector;
+
+	auto Consider = [&](const AActor* NeighborActor, const FVector& NeighborLocation, float Depth, const FVector& Normal)
+	{
+		if (Depth > DeepestDepth)
+		{
+			DeepestDepth = Depth;
+			DeepestActor = NeighborActor;
+			DeepestLocation = NeighborLocation;
+			DeepestNormal = Normal;
+		}
+	};
+
+	// Capsules and spheres tested as circles are batched 4 at a time
+	const bool bIs2D = ScanParams->bDirectionIs2D;
+	const bool bBatchCircles = bIs2D && !Shape.IsBox();
+	const float Radius = Shape.IsCapsule() ? Shape.GetCapsuleRadius() : Shape.GetSphereRadius();
+	const float HalfHeight = Shape.IsCapsule() ? Shape.GetCapsuleHalfHeight() : Shape.GetSphereRadius();
+
+	alignas(16) float BatchX[4];
+	alignas(16) float BatchY[4];
+	alignas(16) float BatchZ[4];
+	alignas(16) float BatchRadius[4];
+	alignas(16) float BatchHalfHeight[4];
+	alignas(16) float BatchDepth[4];
+	const AActor* BatchActors[4];
+	FVector BatchLocations[4];
+	int32 BatchNum = 0;
+
+	auto FlushBatch = [&]()
+	{
+		// Unused lanes are ignored via a negative radius
+		for (int32 Lane = BatchNum; Lane < 4; Lane++)
+		{
+			BatchX[Lane] = BatchY[Lane] = BatchZ[Lane] = BatchHalfHeight[Lane] = 0.f;
+			BatchRadius[Lane] = -1.f;
+		}
+
+		// Candidates are relative to us, so the lanes keep their precision far from the origin
+		UPushStatics::ComputeCircleOverlap4(FVector::ZeroVector, Radius, HalfHeight, BatchX, BatchY, BatchZ, BatchRadius,
+			BatchHalfHeight, BatchDepth);
+
+		for (int32 Lane = 0; Lane < BatchNum; Lane++)
+		{
+			if (BatchDepth[Lane] >= 0.f)
+			{
+				const FVector Normal = (Location - BatchLocations[Lane]).GetSafeNormal2D();
+				Consider(BatchActors[Lane], BatchLocations[Lane], BatchDepth[Lane], Normal);
+			}
+		}
+		BatchNum = 0;
+	};
+
+	for (const FPushPawnNeighbor& Neighbor : Neighbors)
+	{
+		const AActor* NeighborActor = Neighbor.Actor.Get();
+		if (!NeighborActor)
+		{
+			continue;
+		}
+
+		const FVector NeighborLocation = NeighborActor->GetActorLocation();
+		float Depth;
+		FVector Normal;
+
+		if (Neighbor.bAnalytic)
+		{
+			if (bBatchCircles && !Neighbor.Shape.IsBox())
+			{
+				const FVector3f Offset(NeighborLocation - Location);
+				BatchX[BatchNum] = Offset.X;
+				BatchY[BatchNum] = Offset.Y;
+				BatchZ[BatchNum] = Offset.Z;
+				BatchLocations[BatchNum] = NeighborLocation;
+				BatchRadius[BatchNum] = Neighbor.Shape.IsCapsule() ? Neighbor.Shape.GetCapsuleRadius() : Neighbor.Shape.GetSphereRadius();
+				BatchHalfHeight[BatchNum] = Neighbor.Shape.IsCapsule() ? Neighbor.Shape.GetCapsuleHalfHeight() : Neighbor.Shape.GetSphereRadius();
+				BatchActors[BatchNum] = NeighborActor;
+				if (++BatchNum == 4)
+				{
+					FlushBatch();
+				}
+				continue;
+			}
+
+			const FQuat NeighborRotation = NeighborActor->GetActorQuat() * Neighbor.ShapeRotation;
+			if (UPushStatics::ComputeShapeOverlap(Shape, Location, Rotation, Neighbor.Shape, NeighborLocation,
+				NeighborRotation, bIs2D, Depth, Normal))
+			{
+				Consider(NeighborActor, NeighborLocation, Depth, Normal);
+			}
+		}
+		else if (const UPrimitiveComponent* Component = Neighbor.Component.Get())
+		{
+			// Not a pushee with a known shape, fall back to physics
+			FMTDResult MTD;
+			if (Component->ComputePenetration(MTD, Shape, Location, Rotation))
+			{
+				Consider(NeighborActor, NeighborLocation, MTD.Distance, MTD.Direction);
+			}
+		}
+	}
+
+	if (BatchNum > 0)
+	{
+		FlushBatch();
+	}
+
+	if (DeepestActor)
+	{
+		OutHitResult.HitObjectHandle = FActorInstanceHandle(const_cast<AActor*>(DeepestActor));
+		OutHitResult.Component = Cast<UPrimitiveComponent>(DeepestActor->GetRootComponent());
+		OutHitResult.Location = Location;
+		OutHitResult.ImpactPoint = DeepestLocation;
+		OutHitResult.Normal = DeepestNormal;
+		OutHitResult.ImpactNormal = DeepestNormal;
+		OutHitResult.PenetrationDepth = DeepestDepth;
+		OutHitResult.bBlockingHit = true;
+		OutHitResult.bStartPenetrating = true;
+	}
+}
+
+void UAbilityTask_PushPawnScan::UpdateTimeToContact(FPushPawnScanContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAbilityTask_PushPawnScan::UpdateTimeToContact);
+
+	// Centralized scans already found the earliest contact from the grid in the read phase
+	float TimeToContact = ScanParams->MaxScanInterval;
+	if (!ScanParams->bCentralizedScan)
+	{
+		TimeToContact = FMath::Min(TimeToContact, FindNeighborTimeToContact(Context));
+	}
+
+	// Something is already in range, keep scanning at the regular rate while we're being pushed
+	if (Context.TimeToContact == 0.f || Context.Hit.bBlockingHit || CurrentOptions.Num() > 0)
+	{
+		TimeToContact = FMath::Min(TimeToContact, UPushStatics::GetPushPawnScanRate(Context.Acceleration, *ScanParams));
+	}
+	else if (Context.TimeToContact > 0.f)
+	{
+		TimeToContact = FMath::Min(TimeToContact, Context.TimeToContact);
+	}
+
+	TimeToContactInterval = FMath::Clamp(TimeToContact, ScanParams->MinScanInterval, ScanParams->MaxScanInterval);
+}
+
+float UAbilityTask_PushPawnScan::FindNeighborTimeToContact(FPushPawnScanContext& Context)
+{
+	// Candidates come from the neighbor list, which is only queried again once it may be stale
+	const UWorld* World = GetWorld();
+	if (ShouldRebuildNeighbors(Context.Location))
+	{
+		RebuildNeighbors(World, Context.Location, Context.ShapeRotation, Context.Shape, Context.ShapeScalar,
+			MakeQueryParams(Context.AvatarActor));
+	}
+
+	// Contact is measured against our scaled scan shape, the same shape that finds push options
+	const float Radius = UPushStatics::GetShapeRadius2D(Context.Shape);
+
+	// Find the earliest contact with any neighbor
+	UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this);
+	FPushPawnSnapshot* Snapshot = Subsystem ? &Subsystem->GetSnapshot() : nullptr;
+	for (const FPushPawnNeighbor& Neighbor : Neighbors)
+	{
+		AActor* Candidate = Neighbor.Actor.Get();
+		if (!Candidate)
+		{
+			continue;
+		}
+
+		FVector CandidateVelocity;
+		const int32 CandidateIndex = Snapshot ? Snapshot->FindOrCapture(Candidate) : INDEX_NONE;
+		if (CandidateIndex != INDEX_NONE)
+		{
+			CandidateVelocity = Snapshot->Velocities[CandidateIndex];
+		}
+		else
+		{
+			const IPusheeInstigator* CandidatePushee = UPushStatics::GetPusheeInstigator(Candidate);
+			CandidateVelocity = CandidatePushee ? CandidatePushee->GetPusheeVelocity() : Candidate->GetVelocity();
+		}
+
+		const float CandidateRadius = Neighbor.Shape.IsNearlyZero() ? Candidate->GetSimpleCollisionRadius() :
+			UPushStatics::GetShapeRadius2D(Neighbor.Shape);
+		const float CandidateTimeToContact = UPushStatics::GetTimeToContact(Context.Location, Context.Velocity, Radius,
+			Candidate->GetActorLocation(), CandidateVelocity, CandidateRadius, ScanParams->bDirectionIs2D);
+		if (CandidateTimeToContact < 0.f || CandidateTimeToContact > ScanParams->MaxScanInterval)
+		{
+			continue;
+		}
+
+		// Candidate will reach us before our next scan, it must be awake to push us back
+		if (Subsystem)
+		{
+			Subsystem->WakeScan(Candidate);
+		}
+
+		Context.TimeToContact = Context.TimeToContact < 0.f ? CandidateTimeToContact :
+			FMath::Min(Context.TimeToContact, CandidateTimeToContact);
+	}
+
+	// Pawns outside the list are at least the skin away, less however far they could have closed since it was built
+	if (ScanParams->MaxClosingSpeed > 0.f)
+	{
+		const float TimeSinceRebuild = World->GetTimeSeconds() - NeighborListTime;
+		return GetNeighborSkin() / ScanParams->MaxClosingSpeed - TimeSinceRebuild;
+	}
+	return ScanParams->MaxScanInterval;
+}
+
+float UAbilityTask_PushPawnScan::GetNeighborSkin() const
+{
+	// Time-to-contact scheduling must see anything that can reach us before our longest scan interval
+	if (ScanParams->bTimeToContactScheduling)
+	{
+		return FMath::Max(ScanParams->NeighborSkin, ScanParams->MaxClosingSpeed * ScanParams->MaxScanInterval);
+	}
+	return ScanParams->NeighborSkin;
+}
+
 void UAbilityTask_PushPawnScan::OnScanPaused(bool bIsPaused)
 {
 #if !UE_BUILD_SHIPPING
@@ -414,6 +1382,10 @@ void UAbilityTask_PushPawnScan::OnScanPaused(bool bIsPaused)
 	if (bIsPaused)
 	{
 		GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+		if (UPushPawnSubsystem* Subsystem = UPushPawnSubsystem::Get(this))
+		{
+			Subsystem->UnscheduleScan(this);
+		}
 		Pause();
 	}
 	else
@@ -2,6 +2,8 @@
 
 #include "Tasks/AbilityTask_PushPawnScan_Base.h"
 
+#include "Abilities/PushPawn_Scan_Base.h"
+#include "PushPawnStats.h"
 #include "GameFramework/Actor.h"
 #include "AbilitySystemComponent.h"
 
@@ -18,29 +20,47 @@ UAbilityTask_PushPawnScan_Base::UAbilityTask_PushPawnScan_Base(const FObjectInit
 void UAbilityTask_PushPawnScan_Base::ShapeTrace(FHitResult& OutHitResult, const UWorld* World, const FVector& Center,
 	const FQuat& Rotation, const ECollisionChannel ChannelName, const FCollisionQueryParams& Params, const FCollisionShape& Shape)
 {
-	check(World);
-
 	// Make it move so the sweep registers
 	const FVector End = Center + FVector::UpVector * -0.1f;
 
+	ShapeSweep(OutHitResult, World, Center, End, Rotation, ChannelName, Params, Shape);
+}
+
+void UAbilityTask_PushPawnScan_Base::ShapeSweep(FHitResult& OutHitResult, const UWorld* World, const FVector& Start,
+	const FVector& End, const FQuat& Rotation, const ECollisionChannel ChannelName, const FCollisionQueryParams& Params,
+	const FCollisionShape& Shape)
+{
+	check(World);
+
 	// Perform the trace
 	OutHitResult = FHitResult();
 	TArray<FHitResult> HitResults;
-	World->SweepMultiByChannel(HitResults, Center, End, Rotation, ChannelName, Shape, Params);
+	World->SweepMultiByChannel(HitResults, Start, End, Rotation, ChannelName, Shape, Params);
 
 	// Set the trace start and end
-	OutHitResult.TraceStart = Center;
+	OutHitResult.TraceStart = Start;
 	OutHitResult.TraceEnd = End;
 
-	// If we hit something, set the first hit result
+	// If we hit something, set the earliest hit result
 	if (HitResults.Num() > 0)
 	{
-		OutHitResult = HitResults[0];
+		const FHitResult* EarliestHit = &HitResults[0];
+		for (const FHitResult& HitResult : HitResults)
+		{
+			if (HitResult.Time < EarliestHit->Time)
+			{
+				EarliestHit = &HitResult;
+			}
+		}
+		OutHitResult = *EarliestHit;
 	}
 }
 
-void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQuery, const TArray<TScriptInterface<IPusherTarget>>& PushTargets)
+void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQuery, const TArray<TScriptInterface<IPusherTarget>>& PushTargets,
+	float LocationTolerance)
 {
+	LLM_SCOPE_BYTAG(PushPawn);
+
 	// Iterate over all the push targets and gather their push options
 	TArray<FPushOption> NewOptions;
 	for (const TScriptInterface<IPusherTarget>& PushTarget : PushTargets)
@@ -53,19 +73,6 @@ void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQue
 		// Iterate over the options and update their parameters and filter out any that can't be activated
 		for (FPushOption& Option : PushOptions)
 		{
-			// Grant the ability to the GAS, otherwise it won't be able to do whatever the Push is.
-			const bool bAuthority = AbilitySystemComponent.IsValid() && AbilitySystemComponent->GetOwnerRole() == ROLE_Authority;
-			if (bAuthority && Option.PushAbilityToGrant)
-			{
-				FObjectKey ObjectKey { Option.PushAbilityToGrant };
-				if (!PushAbilityCache.Find(ObjectKey))
-				{
-					FGameplayAbilitySpec Spec(Option.PushAbilityToGrant, 1, INDEX_NONE);
-					FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
-					PushAbilityCache.Add(ObjectKey, Handle);
-				}
-			}
-
 			// If there is a handle and a target ability system, we're triggering the ability on the target
 			const FGameplayAbilitySpec* PushAbilitySpec = nullptr;
 			if (Option.TargetAbilitySystem && Option.TargetPushAbilityHandle.IsValid())
@@ -79,6 +86,22 @@ void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQue
 				// Find the spec
 				PushAbilitySpec = AbilitySystemComponent->FindAbilitySpecFromClass(Option.PushAbilityToGrant);
 
+				// Wasn't pre-granted, grant the ability to the GAS, otherwise it won't be able to do whatever the Push is.
+				const bool bAuthority = AbilitySystemComponent->GetOwnerRole() == ROLE_Authority;
+				if (!PushAbilitySpec && bAuthority)
+				{
+					FObjectKey ObjectKey { Option.PushAbilityToGrant };
+					if (!PushAbilityCache.Find(ObjectKey))
+					{
+						INC_DWORD_STAT(STAT_PushPawn_LazyGrants);
+
+						FGameplayAbilitySpec Spec(Option.PushAbilityToGrant, 1, INDEX_NONE);
+						FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
+						PushAbilityCache.Add(ObjectKey, Handle);
+						PushAbilitySpec = AbilitySystemComponent->FindAbilitySpecFromHandle(Handle);
+					}
+				}
+
 				if (PushAbilitySpec)
 				{
 					// Update the option
@@ -93,6 +116,12 @@ void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQue
 				if (PushAbilitySpec->Ability->CanActivateAbility(PushAbilitySpec->Handle, AbilitySystemComponent->AbilityActorInfo.Get()))
 				{
 					NewOptions.Add(Option);
+
+					// Only specs on our own ability system can be vouched for when triggering
+					if (PushScanAbility && Option.TargetAbilitySystem == AbilitySystemComponent.Get())
+					{
+						PushScanAbility->MarkPrevalidated(PushAbilitySpec->Handle);
+					}
 				}
 			}
 		}
@@ -100,20 +129,24 @@ void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQue
 
 	// Sort the options
 	bool bOptionsChanged = false;
+	bool bWithinTolerance = false;
 	if (NewOptions.Num() == CurrentOptions.Num())
 	{
 		NewOptions.Sort();
 
+		// Locations within tolerance are refreshed below without a broadcast
+		const float Tolerance = FMath::Max(LocationTolerance, UE_KINDA_SMALL_NUMBER);
 		for (int32 OptionIndex = 0; OptionIndex < NewOptions.Num(); OptionIndex++)
 		{
 			const FPushOption& NewOption = NewOptions[OptionIndex];
 			const FPushOption& CurrentOption = CurrentOptions[OptionIndex];
 
-			if (NewOption != CurrentOption)
+			if (!NewOption.Equals(CurrentOption, Tolerance))
 			{
 				bOptionsChanged = true;
 				break;
 			}
+			bWithinTolerance |= NewOption != CurrentOption;
 		}
 	}
 	else
@@ -124,9 +157,28 @@ void UAbilityTask_PushPawnScan_Base::UpdatePushOptions(const FPushQuery& PushQue
 	// If the options have changed, update the options and broadcast the change
 	if (bOptionsChanged)
 	{
+		INC_DWORD_STAT(STAT_PushPawn_OptionChanges);
+
 		CurrentOptions = NewOptions;
 		PushObjectsChanged.Broadcast(CurrentOptions);
 	}
+	else if (bWithinTolerance)
+	{
+		INC_DWORD_STAT(STAT_PushPawn_OptionChangesSuppressed);
+
+		// Same pushers, keep their locations current so the next push direction isn't stale
+		CurrentOptions = NewOptions;
+		if (PushScanAbility)
+		{
+			PushScanAbility->UpdatePushes(CurrentOptions);
+		}
+	}
+}
+
+void UAbilityTask_PushPawnScan_Base::AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const
+{
+	Usage.Options += CurrentOptions.GetAllocatedSize();
+	Usage.Caches += PushAbilityCache.GetAllocatedSize();
 }
 
 void UAbilityTask_PushPawnScan_Base::OnDestroy(bool bInOwnerFinished)
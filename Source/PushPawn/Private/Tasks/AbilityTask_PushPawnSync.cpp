@@ -9,6 +9,7 @@ UAbilityTask_PushPawnSync::UAbilityTask_PushPawnSync(const FObjectInitializer& O
 	: Super(ObjectInitializer)
 {
 	ReplicatedEventToListenFor = EAbilityGenericReplicatedEvent::MAX;
+	SignalEvent = EAbilityGenericReplicatedEvent::GenericSignalFromClient;
 }
 
 void UAbilityTask_PushPawnSync::OnSignalCallback()
@@ -20,9 +21,11 @@ void UAbilityTask_PushPawnSync::OnSignalCallback()
 	SyncFinished();
 }
 
-UAbilityTask_PushPawnSync* UAbilityTask_PushPawnSync::WaitNetSync(class UGameplayAbility* OwningAbility)
+UAbilityTask_PushPawnSync* UAbilityTask_PushPawnSync::WaitNetSync(class UGameplayAbility* OwningAbility,
+	EAbilityGenericReplicatedEvent::Type SignalEvent)
 {
 	UAbilityTask_PushPawnSync* MyObj = NewAbilityTask<UAbilityTask_PushPawnSync>(OwningAbility);
+	MyObj->SignalEvent = SignalEvent;
 	return MyObj;
 }
 
@@ -35,12 +38,12 @@ void UAbilityTask_PushPawnSync::Activate()
 		if (IsPredictingClient())
 		{
 			// As long as the server is waiting (!= OnlyClientWait), send the Server and RPC for this signal
-			AbilitySystemComponent->ServerSetReplicatedEvent(EAbilityGenericReplicatedEvent::GenericSignalFromClient, GetAbilitySpecHandle(), GetActivationPredictionKey(), AbilitySystemComponent->ScopedPredictionKey);
+			AbilitySystemComponent->ServerSetReplicatedEvent(SignalEvent, GetAbilitySpecHandle(), GetActivationPredictionKey(), AbilitySystemComponent->ScopedPredictionKey);
 		}
 		else if (IsForRemoteClient())
 		{
-			// As long as we are waiting (!= OnlyClientWait), listen for the GenericSignalFromClient event
-			ReplicatedEventToListenFor = EAbilityGenericReplicatedEvent::GenericSignalFromClient;
+			// As long as we are waiting (!= OnlyClientWait), listen for the signal event
+			ReplicatedEventToListenFor = SignalEvent;
 		}
 
 		if (ReplicatedEventToListenFor != EAbilityGenericReplicatedEvent::MAX)
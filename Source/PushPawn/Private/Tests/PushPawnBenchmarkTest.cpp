@@ -0,0 +1,180 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+
+#include "PushPawnBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+#include "Editor.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/AutomationTest.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationCommon.h"
+
+namespace PushPawnBenchTest
+{
+	/** Network emulation applied to every net driver, each scenario is run once per profile */
+	struct FEmulationProfile
+	{
+		int32 PktLag;
+		int32 PktLoss;
+	};
+
+	static constexpr FEmulationProfile EmulationProfiles[] = { { 0, 0 }, { 100, 1 }, { 200, 5 } };
+
+	static constexpr EPushPawnBenchScenario Scenarios[] =
+	{
+		EPushPawnBenchScenario::Converge, EPushPawnBenchScenario::Cross, EPushPawnBenchScenario::Orbit
+	};
+
+	/** How long to wait for every player to join before giving up */
+	static constexpr float JoinTimeout = 60.f;
+
+	/** @return The listen server world started by the play session */
+	static UWorld* FindServerWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && Context.WorldType == EWorldType::PIE && World->GetNetMode() == NM_ListenServer)
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+}
+
+/** Start a listen server with clients in this process, so the benchmark can measure the position error between them */
+class FPushPawnBenchStartPlayCommand : public IAutomationLatentCommand
+{
+public:
+	FPushPawnBenchStartPlayCommand(FAutomationTestBase* InTest, int32 InNumPlayers)
+		: Test(InTest)
+		, NumPlayers(InNumPlayers)
+	{}
+
+	virtual bool Update() override
+	{
+		if (!bRequested)
+		{
+			ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+			PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_ListenServer);
+			PlaySettings->SetPlayNumberOfClients(NumPlayers);
+			PlaySettings->SetRunUnderOneProcess(true);
+			PlaySettings->bLaunchSeparateServer = false;
+
+			FRequestPlaySessionParams Params;
+			Params.EditorPlaySettings = PlaySettings;
+			GEditor->RequestPlaySession(Params);
+
+			bRequested = true;
+			return false;
+		}
+
+		// Every player has joined and has a pawn on the server
+		const UWorld* ServerWorld = PushPawnBenchTest::FindServerWorld();
+		const AGameStateBase* GameState = ServerWorld ? ServerWorld->GetGameState() : nullptr;
+		if (GameState && GameState->PlayerArray.Num() >= NumPlayers && !GameState->PlayerArray.ContainsByPredicate(
+			[](const APlayerState* PlayerState) { return !PlayerState || !PlayerState->GetPawn(); }))
+		{
+			return true;
+		}
+
+		if (GetCurrentRunTime() > PushPawnBenchTest::JoinTimeout)
+		{
+			Test->AddError(FString::Printf(TEXT("Timed out waiting for %d players to join"), NumPlayers));
+			return true;
+		}
+		return false;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	int32 NumPlayers;
+	bool bRequested = false;
+};
+
+/** Apply the emulation profile, then run a scenario until the benchmark has written its results */
+class FPushPawnBenchRunCommand : public IAutomationLatentCommand
+{
+public:
+	FPushPawnBenchRunCommand(FAutomationTestBase* InTest, EPushPawnBenchScenario InScenario, float InDuration,
+		const PushPawnBenchTest::FEmulationProfile& InProfile)
+		: Test(InTest)
+		, Scenario(InScenario)
+		, Duration(InDuration)
+		, Profile(InProfile)
+	{}
+
+	virtual bool Update() override
+	{
+		if (!bStarted)
+		{
+			if (!PushPawnBenchTest::FindServerWorld())
+			{
+				Test->AddError(TEXT("No play session to benchmark"));
+				return true;
+			}
+
+#if DO_ENABLE_NET_TEST
+			for (const FWorldContext& Context : GEngine->GetWorldContexts())
+			{
+				const UWorld* World = Context.World();
+				if (UNetDriver* NetDriver = World && World->IsGameWorld() ? World->GetNetDriver() : nullptr)
+				{
+					FPacketSimulationSettings Settings = NetDriver->PacketSimulationSettings;
+					Settings.PktLag = Profile.PktLag;
+					Settings.PktLoss = Profile.PktLoss;
+					NetDriver->SetPacketSimulationSettings(Settings);
+				}
+			}
+#endif
+
+			FPushPawnBenchmark::Start(Scenario, Duration);
+			bStarted = true;
+			return false;
+		}
+
+		// Results are written when the benchmark stops itself
+		return !FPushPawnBenchmark::IsRunning();
+	}
+
+private:
+	FAutomationTestBase* Test;
+	EPushPawnBenchScenario Scenario;
+	float Duration;
+	PushPawnBenchTest::FEmulationProfile Profile;
+	bool bStarted = false;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPushPawnBenchmarkTest, "PushPawn.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter)
+
+/**
+ * Run every benchmark scenario under every emulation profile, in the map currently open in the editor
+ * -PushPawnBenchPlayers=4 and -PushPawnBenchDuration=30 override the defaults
+ */
+bool FPushPawnBenchmarkTest::RunTest(const FString& Parameters)
+{
+	int32 NumPlayers = 4;
+	FParse::Value(FCommandLine::Get(), TEXT("PushPawnBenchPlayers="), NumPlayers);
+
+	float Duration = 30.f;
+	FParse::Value(FCommandLine::Get(), TEXT("PushPawnBenchDuration="), Duration);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FPushPawnBenchStartPlayCommand(this, FMath::Max(NumPlayers, 2)));
+	for (const PushPawnBenchTest::FEmulationProfile& Profile : PushPawnBenchTest::EmulationProfiles)
+	{
+		for (const EPushPawnBenchScenario Scenario : PushPawnBenchTest::Scenarios)
+		{
+			ADD_LATENT_AUTOMATION_COMMAND(FPushPawnBenchRunCommand(this, Scenario, FMath::Max(Duration, 1.f), Profile));
+		}
+	}
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif
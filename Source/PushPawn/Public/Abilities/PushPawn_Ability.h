@@ -4,8 +4,30 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
+#include "UObject/ObjectKey.h"
 #include "PushPawn_Ability.generated.h"
 
+/**
+ * While in scope, UPushPawn_Ability::CanActivateAbility() skips looking up the given spec, which was already found
+ * moments ago by UAbilityTask_PushPawnScan_Base::UpdatePushOptions()
+ * The avatar, role, and CanActivatePushPawnAbility() checks still run against the actor info being activated with
+ * @see UPushPawn_Scan_Base::ConsumePrevalidated()
+ */
+struct PUSHPAWN_API FPushPawnPrevalidatedScope
+{
+	/** @param bPrevalidated If false, the scope is empty and hides any outer scope */
+	FPushPawnPrevalidatedScope(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle,
+		bool bPrevalidated);
+	~FPushPawnPrevalidatedScope();
+
+	/** @return True if the innermost scope is open for the spec, only once per scope */
+	static bool ConsumePrevalidated(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle);
+
+private:
+	FObjectKey PreviousAbilitySystem;
+	FGameplayAbilitySpecHandle PreviousHandle;
+};
+
 /**
  * The minimal ability class used for PushPawn
  * This is a lightweight class that cannot use tags or other advanced features to reduce performance overhead
@@ -36,6 +58,10 @@ protected:
 	/** @return True if the ability was not ended or cancelled */
 	virtual bool ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
 	const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) { return true; }
+
+	/** Called after the ability was committed, if ActivatePushPawnAbility() succeeded and Blueprint implementation is not allowed */
+	virtual void OnPushPawnAbilityCommitted(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo) {}
 	
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
 		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override final;
@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "PushPawn_Action_Base.h"
 #include "PushTypes.h"
+#include "PushPawnStrength.h"
 #include "PushPawn_Action.generated.h"
 
-class ACharacter;
+class APawn;
+class UPushPawnProfile;
 
 /**
  * A completed C++ implementation of the PushPawn_Action_Base class
@@ -26,14 +28,21 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
 	FPushPawnActionParams PushParams;
 
+	/** Shared action parameters with pre-baked curves, used instead of PushParams if set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	TObjectPtr<const UPushPawnProfile> Profile;
+
+	/** Bound to PushParams whenever they are initialized or change */
+	FPushPawnStrengthEvaluator StrengthEvaluator;
+
 protected:
 	// Cache transient data so derived classes can access it
 
 	UPROPERTY(BlueprintReadOnly, Transient, DuplicateTransient, Category=PushPawn)
-	TObjectPtr<const ACharacter> Pushee = nullptr;
+	TObjectPtr<const APawn> Pushee = nullptr;
 
 	UPROPERTY(BlueprintReadOnly, Transient, DuplicateTransient, Category=PushPawn)
-	TObjectPtr<const ACharacter> Pusher = nullptr;
+	TObjectPtr<const APawn> Pusher = nullptr;
 	
 	UPROPERTY(BlueprintReadOnly, Transient, DuplicateTransient, Category=PushPawn)
 	FVector PushDirection = FVector::ZeroVector;
@@ -53,6 +62,20 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Transient, DuplicateTransient, Category=PushPawn)
 	bool bOverrideStrength = false;
 	
+public:
+	/** @return The profile's action parameters if we have one, otherwise our own */
+	const FPushPawnActionParams& GetPushParams() const;
+
+	/** @return The profile's strength evaluator if we have one, otherwise our own */
+	const FPushPawnStrengthEvaluator& GetStrengthEvaluator() const;
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
 	virtual bool ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
 		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
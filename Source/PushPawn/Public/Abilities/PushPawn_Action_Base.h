@@ -26,4 +26,13 @@ public:
 protected:
 	/** Helper for derived actions to retrieve p.PushPawn.Action.Debug.Draw which is declared in UPushPawn_Action cpp */
 	static bool WantsPushPawnActionDebugDraw();
+
+	/**
+	 * On authority, verify a push predicted by the owning client, because we no longer scan for it ourselves
+	 * Pushes found by our own scan are not verified, the client's are rejected unless Pushee is its own avatar
+	 * @return False if the push should be rejected
+	 * @see UPushPawnSettings::bVerifyClientPushes, UPushPawnSubsystem::VerifyClientPush()
+	 */
+	static bool VerifyClientPush(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo& ActivationInfo,
+		const AActor* Pushee, const AActor* Pusher, const FVector& Direction, float Distance, bool bDistance2D);
 };
@@ -0,0 +1,103 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PushPawn_Action_Base.h"
+#include "PushTypes.h"
+#include "PushPawnStrength.h"
+#include "PushPawnStats.h"
+#include "UObject/ObjectKey.h"
+#include "PushPawn_Action_NonInstanced.generated.h"
+
+class UPushPawnMovementBackend;
+class UPushPawnProfile;
+
+/** The push applied by a single activation of UPushPawn_Action_NonInstanced */
+struct FPushPawnActionState
+{
+	TWeakObjectPtr<UActorComponent> MovementComponent;
+	TWeakObjectPtr<const UPushPawnMovementBackend> MovementBackend;
+	int32 PushID = INDEX_NONE;
+
+	/** @return True if the push is still applied */
+	bool IsActive() const;
+};
+
+/**
+ * Spec handles are only unique per ability system, and the class default object is shared by every world in the
+ * process, e.g. in PIE, so states are keyed by both
+ */
+using FPushPawnActionStateKey = TPair<FObjectKey, FGameplayAbilitySpecHandle>;
+
+/**
+ * A non-instanced equivalent of UPushPawn_Action
+ * Every pawn shares the class default object, so no ability or task UObjects are created per pawn or per push
+ *
+ * The push force is applied directly through the avatar's UPushPawnMovementBackend and the ability ends immediately,
+ * the push expires on its own after FPushPawnActionParams::Duration
+ * Retriggering removes the previous push, the same as UPushPawn_Action
+ *
+ * Per-activation state cannot live on the ability, it is kept in a compact map keyed by ability system and spec handle
+ * Blueprint implementation is not supported
+ *
+ * Only supported before UE 5.5, where non-instanced abilities are deprecated, use UPushPawn_Action from 5.5 onward
+ */
+UCLASS()
+class PUSHPAWN_API UPushPawn_Action_NonInstanced final : public UPushPawn_Action_Base
+{
+	GENERATED_BODY()
+
+protected:
+	/** The parameters to apply to the pushee */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	FPushPawnActionParams PushParams;
+
+	/** Shared action parameters with pre-baked curves, used instead of PushParams if set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	TObjectPtr<const UPushPawnProfile> Profile;
+
+	/** Bound to PushParams whenever they are initialized or change */
+	FPushPawnStrengthEvaluator StrengthEvaluator;
+
+	/** Push applied by each spec, pruned once it expires */
+	TMap<FPushPawnActionStateKey, FPushPawnActionState> ActiveStates;
+
+public:
+	UPushPawn_Action_NonInstanced(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** @return The profile's action parameters if we have one, otherwise our own */
+	const FPushPawnActionParams& GetPushParams() const;
+
+	/** @return The profile's strength evaluator if we have one, otherwise our own */
+	const FPushPawnStrengthEvaluator& GetStrengthEvaluator() const;
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** @return The push currently applied by the spec on AbilitySystem, if any */
+	const FPushPawnActionState* GetActiveState(const UAbilitySystemComponent* AbilitySystem,
+		FGameplayAbilitySpecHandle Handle) const;
+
+	/** Add the memory held by the shared state map to Usage, see p.PushPawn.MemReport */
+	void AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const { Usage.Caches += ActiveStates.GetAllocatedSize(); }
+
+protected:
+	virtual bool ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+
+	virtual void OnPushPawnAbilityCommitted(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo) override;
+
+	virtual void OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+
+	/** Remove any push still applied by the spec on AbilitySystem */
+	void RemoveActiveState(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle);
+
+	/** Remove states whose push has expired */
+	void PruneActiveStates();
+};
@@ -6,8 +6,13 @@
 #include "PushOption.h"
 #include "PushPawn_Ability.h"
 #include "PushTypes.h"
+#include "PushPawnStats.h"
 #include "PushPawn_Scan_Base.generated.h"
 
+class UPushPawnProfile;
+struct FPushPawnAbilityTargetData;
+struct FPushPawnStrengthTargetData;
+
 /**
  * The base class for all PushPawn scanning
  * This is a lightweight class that cannot use tags or other advanced features to reduce performance overhead
@@ -26,6 +31,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
 	FPushPawnScanParams ScanParams;
 
+	/**
+	 * Shared scan parameters, used instead of ScanParams if set
+	 * Pawns that share a profile don't each carry their own copy of the parameters, and its curves are pre-baked
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	TObjectPtr<const UPushPawnProfile> Profile;
+
 	/** Information needed to push a pawn. */
 	UPROPERTY(BlueprintReadWrite, Category=PushPawn)
 	TArray<FPushOption> CurrentOptions;
@@ -38,6 +50,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AdvancedDisplay, Category=PushPawn)
 	bool bAutoActivateOnGrantAbility = true;
 
+	/**
+	 * Push abilities granted on authority when our avatar is set, along with UPushPawnSettings::PreGrantedPushAbilities
+	 * Any FPushOption::PushAbilityToGrant that wasn't pre-granted is granted on first contact instead, which can hitch
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	TArray<TSubclassOf<UGameplayAbility>> PushAbilitiesToPreGrant;
+
 protected:
 	/**
 	 * If FALSE, will never net sync, and de-sync is guaranteed
@@ -94,23 +113,71 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category=PushPawn)
 	float LastNetSyncTime = 0.f;
 
+	/**
+	 * The avatar's movement predicts and reconciles pushes itself, so there is nothing for a net sync to correct
+	 * @see UPushPawnMovementBackend::IsPredictedByMovement()
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="PushPawn|Net Sync")
+	bool bPushesPredictedByMovement = false;
+
+protected:
+	/** Actor info passed when triggering pushes, per target ability system, rebuilt when the owner or avatar changes */
+	TMap<TObjectKey<UAbilitySystemComponent>, FGameplayAbilityActorInfo> TargetActorInfoCache;
+
+	/** When each pusher last pushed us, used to enforce FPushPawnScanParams::MinPushInterval */
+	TMap<TObjectKey<AActor>, float> LastPushTimeByPusher;
+
+	/** Retries a push suppressed by FPushPawnScanParams::MinPushInterval once the interval has elapsed */
+	FTimerHandle SuppressedPushTimerHandle;
+
+	/** Reused by each push unless something is still holding onto the previous one */
+	TSharedPtr<FPushPawnAbilityTargetData> PooledTargetData;
+	TSharedPtr<FPushPawnStrengthTargetData> PooledStrengthTargetData;
+
+	/** Push ability specs on our own ability system found while gathering push options this frame */
+	TArray<FGameplayAbilitySpecHandle> PrevalidatedHandles;
+	uint64 PrevalidatedFrame = 0;
+
 public:
 	UPushPawn_Scan_Base(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	virtual void OnGameplayTaskInitialized(UGameplayTask& Task) override;
 
 	virtual void OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+
+	/** @return The profile's scan parameters if we have one, otherwise our own */
+	const FPushPawnScanParams& GetScanParams() const;
+
+	const UPushPawnProfile* GetProfile() const { return Profile; }
+
+	/** Add the memory held by our containers to Usage, see p.PushPawn.MemReport */
+	void AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const;
+
+	/**
+	 * Record that the push ability spec on our own ability system passed CanActivateAbility() this frame
+	 * @see FPushPawnPrevalidatedScope
+	 */
+	void MarkPrevalidated(FGameplayAbilitySpecHandle Handle);
 	
 protected:
+	/** @return True if Handle was marked this frame, the mark is cleared */
+	bool ConsumePrevalidated(FGameplayAbilitySpecHandle Handle);
+
 	virtual bool ActivatePushPawnAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
 		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
 
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+
 	UFUNCTION(BlueprintCallable, Category=PushPawn)
 	void UpdatePushes(const TArray<FPushOption>& PushOptions);
 
 	UFUNCTION(BlueprintCallable, Category=PushPawn)
 	void TriggerPush();
 
+	/** @return Actor info for triggering a push on AbilitySystem, cached until the owner or avatar changes */
+	FGameplayAbilityActorInfo* GetTargetActorInfo(AActor* OwnerActor, AActor* AvatarActor, UAbilitySystemComponent* AbilitySystem);
+
 protected:
 	/**
 	 * Get the base scan range for the pawn
@@ -0,0 +1,203 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "PushPawnMovementBackend.h"
+#include "PushPawnCharacterMovement.generated.h"
+
+class UCurveFloat;
+
+/** The push state at the start of a move, replayed when the client is corrected */
+class PUSHPAWN_API FSavedMove_PushPawn : public FSavedMove_Character
+{
+	using Super = FSavedMove_Character;
+
+public:
+	FVector PushVelocity = FVector::ZeroVector;
+	float PushElapsed = 0.f;
+	float PushDuration = 0.f;
+	FVector AppliedPushVelocity = FVector::ZeroVector;
+
+	/** Pushes added since the previous move, folded on top of the server's push state when the move is replayed */
+	FVector AddedPushVelocity = FVector::ZeroVector;
+	float AddedPushDuration = 0.f;
+
+	/** @return True if a push was in progress when the move started */
+	bool HasPush() const { return PushElapsed < PushDuration || !AppliedPushVelocity.IsZero(); }
+
+	virtual void Clear() override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual bool IsImportantMove(const FSavedMovePtr& LastAckedMove) const override;
+};
+
+class PUSHPAWN_API FNetworkPredictionData_Client_PushPawn : public FNetworkPredictionData_Client_Character
+{
+	using Super = FNetworkPredictionData_Client_Character;
+
+public:
+	FNetworkPredictionData_Client_PushPawn(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
+
+/**
+ * The push state sent with each move
+ * A single bit when there is no push, otherwise a quantized velocity and two bytes of timing
+ */
+struct PUSHPAWN_API FPushPawnNetworkMoveData : public FCharacterNetworkMoveData
+{
+	using Super = FCharacterNetworkMoveData;
+
+	FVector_NetQuantize10 PushVelocity = FVector::ZeroVector;
+
+	/** Hundredths of a second */
+	uint8 PushElapsed = 0;
+	uint8 PushDuration = 0;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct PUSHPAWN_API FPushPawnNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FPushPawnNetworkMoveDataContainer();
+
+	FPushPawnNetworkMoveData MoveData[3];
+};
+
+/**
+ * The server's push state sent with each correction, so the client replays from it instead of its own
+ * Quantized the same way as FPushPawnNetworkMoveData, and a single bit when there is no push
+ */
+struct PUSHPAWN_API FPushPawnMoveResponseDataContainer : public FCharacterMoveResponseDataContainer
+{
+	using Super = FCharacterMoveResponseDataContainer;
+
+	FVector_NetQuantize10 PushVelocity = FVector::ZeroVector;
+	FVector_NetQuantize10 AppliedPushVelocity = FVector::ZeroVector;
+
+	/** Hundredths of a second */
+	uint8 PushElapsed = 0;
+	uint8 PushDuration = 0;
+
+	virtual void ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
+};
+
+/**
+ * Character movement that applies pushes as a velocity instead of a root motion source
+ *
+ * Every push is folded into a single push velocity that decays over the push duration and is added in CalcVelocity()
+ * The push state is saved with each move and sent to the server in a few bytes, instead of going through root motion
+ * source prediction, and simultaneous pushes stack by adding their velocities
+ *
+ * Pushes are routed here by UPushPawnMovementBackend_Velocity
+ * The server applies its own pushes, and only takes the push state from the owning client's moves when it is within
+ * ClientPushTolerance of its own, so the client's timing is kept without letting it push itself
+ * Otherwise the client is corrected, and replays its moves from the server's push state sent with the correction
+ */
+UCLASS(ClassGroup=(PushPawn), meta=(BlueprintSpawnableComponent))
+class PUSHPAWN_API UPushPawnCharacterMovement : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+	friend class FSavedMove_PushPawn;
+	friend struct FPushPawnMoveResponseDataContainer;
+
+public:
+	/** Scales the push velocity over the normalized push duration, the push is constant if not set */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: PushPawn")
+	TObjectPtr<UCurveFloat> PushDecayCurve;
+
+	/**
+	 * How far the client's current push velocity may differ from the server's for the server to take the client's push
+	 * state, otherwise the server keeps its own and the client is corrected
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Character Movement: PushPawn", meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
+	float ClientPushTolerance;
+
+	/** Push timings are sent in hundredths of a second in a byte, longer pushes are clamped */
+	static constexpr float MaxPushDuration = 2.55f;
+
+protected:
+	/** Combined velocity of all pushes in progress, before decay */
+	FVector PushVelocity;
+
+	float PushElapsed;
+	float PushDuration;
+
+	/** The push velocity added to Velocity by the last CalcVelocity() */
+	FVector AppliedPushVelocity;
+
+	/** Owning client, pushes added since the last saved move */
+	FVector AddedPushVelocity;
+	float AddedPushDuration;
+
+	/** Server, the client's push state was outside ClientPushTolerance for the move being processed */
+	bool bClientPushRejected;
+
+	FPushPawnNetworkMoveDataContainer MoveDataContainer;
+	FPushPawnMoveResponseDataContainer MoveResponseDataContainer;
+
+public:
+	UPushPawnCharacterMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/**
+	 * Add a push on top of any push in progress
+	 * Ignored on simulated proxies, their push arrives with replicated movement
+	 * @param InPushVelocity	Velocity to add, direction multiplied by strength
+	 * @param Duration			How long the push lasts, clamped to MaxPushDuration with a warning
+	 */
+	void AddPushVelocity(const FVector& InPushVelocity, float Duration);
+
+	/** @return True if a push is in progress */
+	bool HasPushVelocity() const { return PushElapsed < PushDuration; }
+
+	/** @return The push velocity to apply right now, after decay */
+	FVector GetCurrentPushVelocity() const;
+
+	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+protected:
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	/** Correct the client whenever we rejected its push state, so it replays from ours */
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientLoc,
+		const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName,
+		uint8 ClientMovementMode) override;
+
+	/** Take the server's push state from the correction, before the saved moves are replayed on top of it */
+	virtual void OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp,
+		FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase,
+		bool bBaseRelativePosition, uint8 ServerMovementMode, FVector ServerGravityDirection) override;
+
+	/** Fold a push into the push in progress, so stacked pushes add up and share a single decay */
+	void FoldPushVelocity(const FVector& InPushVelocity, float Duration);
+
+	void ClearPushVelocity();
+};
+
+/**
+ * Pushes UPushPawnCharacterMovement through its push velocity
+ * Falls back to root motion sources for pushes it can't represent, ones that override velocity or bring their own
+ * strength curve
+ */
+UCLASS()
+class PUSHPAWN_API UPushPawnMovementBackend_Velocity : public UPushPawnMovementBackend_Character
+{
+	GENERATED_BODY()
+
+public:
+	/** Returned for velocity pushes, root motion source IDs are always smaller */
+	static constexpr int32 VelocityPushID = MAX_uint16 + 1;
+
+	virtual UActorComponent* FindMovementComponent(const AActor* Avatar) const override;
+	virtual int32 ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const override;
+	virtual void RemovePush(UActorComponent* MovementComponent, int32 PushID) const override;
+	virtual bool IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const override;
+};
@@ -0,0 +1,63 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PusheeComponent.h"
+#include "GameplayTagContainer.h"
+#include "PushTypes.h"
+#include "PusheeCharacterComponent.generated.h"
+
+/**
+ * Native pushee for characters, configured entirely with properties
+ * Reads directly from CharacterOwner and its UCharacterMovementComponent, so no Blueprint VM calls are made while
+ * scanning or pushing. Prefer this over UPusheeComponentHelper unless you need custom logic
+ */
+UCLASS(ClassGroup=(PushPawn), meta=(BlueprintSpawnableComponent))
+class PUSHPAWN_API UPusheeCharacterComponent final
+	: public UPusheeComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Our owner's tags must match this query to be pushed at all, ignored if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	FGameplayTagQuery PushableTagQuery;
+
+	/** The pusher's tags must match this query to push us, ignored if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	FGameplayTagQuery PushedByTagQuery;
+
+	/** Scales how much we are pushed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float StrengthScalar = 1.f;
+
+	/** If true, StrengthOverride replaces the calculated push strength */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	bool bOverrideStrength = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(EditCondition="bOverrideStrength", ClampMin="0", UIMin="0"))
+	float StrengthOverride = 0.f;
+
+	/** The shape used for pushing, detected from the root component if None */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	EPushCollisionType CollisionShapeType = EPushCollisionType::None;
+
+protected:
+	/** Default collision shape, cached on BeginPlay as it must not change at runtime */
+	FCollisionShape CachedShape;
+	FQuat CachedShapeRotation = FQuat::Identity;
+	bool bHasCachedShape = false;
+
+public:
+	virtual void BeginPlay() override;
+
+	virtual bool IsPushable() const override;
+	virtual bool CanBePushedBy(const AActor* PusherActor) const override;
+	virtual float GetPusheeStrengthScalar() const override { return StrengthScalar; }
+	virtual bool GetPusheeStrengthOverride(float& Strength) const override;
+	virtual FVector GetPusheeAcceleration() const override;
+	virtual FVector GetPusheeVelocity() const override;
+	virtual bool IsPusheeMovingOnGround() const override;
+	virtual FCollisionShape GetPusheeCollisionShape(FQuat& ShapeRotation) const override;
+};
@@ -8,6 +8,9 @@
 #include "CollisionShape.h"
 #include "PusheeComponent.generated.h"
 
+class USphereComponent;
+class UPrimitiveComponent;
+struct FHitResult;
 
 /**
  * Optional component for actors that can be pushed
@@ -20,6 +23,56 @@ class PUSHPAWN_API UPusheeComponent
 {
 	GENERATED_BODY()
 
+public:
+	/**
+	 * If true, a lightweight overlap sensor is created around the owner and the scan is paused until at least one
+	 * push-capable actor is inside of it. With no neighbors nearby, no PushPawn work is performed at all
+	 * @note Overriding GetPushPawnScanPausedDelegate() or IsPushPawnScanPaused() will disable the sensor's control over the scan
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="PushPawn|Sensor")
+	bool bUseOverlapSensor = false;
+
+	/** Radius of the overlap sensor, this must exceed the scan range or pushes will be missed */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="PushPawn|Sensor", meta=(EditCondition="bUseOverlapSensor", ClampMin="0", UIMin="0", Delta="1.0", ForceUnits="cm"))
+	float SensorRadius = 200.f;
+
+	/**
+	 * Collision profile for the overlap sensor, it should only overlap pawns
+	 * If the profile doesn't exist, the sensor is query only and overlaps ECC_Pawn
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="PushPawn|Sensor", meta=(EditCondition="bUseOverlapSensor"))
+	FName SensorCollisionProfile = TEXT("PushPawnSensor");
+
+	/** Sensor that wakes the scan when a push-capable actor is nearby */
+	UPROPERTY(Transient, DuplicateTransient, BlueprintReadOnly, Category="PushPawn|Sensor")
+	TObjectPtr<USphereComponent> Sensor;
+
+	/** Categories we belong to and the categories that can push us, e.g. change on team assignment */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	FPushPawnFilter PushFilter;
+
+protected:
+	/** Bound by the scan task when bUseOverlapSensor is enabled */
+	FOnPushPawnScanPaused OnSensorScanPaused;
+
+	/** Overlapping components from push-capable actors */
+	TSet<TObjectKey<UPrimitiveComponent>> SensorOverlaps;
+
+public:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	void CreateSensor();
+
+	UFUNCTION()
+	void OnSensorBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+	void OnSensorEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
 public:
 	/**
 	 * Prevents unnecessary ability activation
@@ -31,6 +84,9 @@ public:
 	/** @return True if we can currently be pushed by the PusherActor */
 	virtual bool CanBePushedBy(const AActor* PusherActor) const override PURE_VIRTUAL(UPusheeComponent::CanBePushedBy, return false;);
 
+	/** @return Categories we belong to and the categories that can push us */
+	virtual FPushPawnFilter GetPusheeFilter() const override { return PushFilter; }
+
 	/** @return Optional runtime strength scaling to change how much the pushee is pushed */
 	virtual float GetPusheeStrengthScalar() const override { return 1.f; }
 
@@ -80,5 +136,8 @@ public:
 	 * 
 	 * @return Delegate for when the scan is paused or resumed
 	 */
-	virtual FOnPushPawnScanPaused* GetPushPawnScanPausedDelegate() override { return nullptr; }
+	virtual FOnPushPawnScanPaused* GetPushPawnScanPausedDelegate() override { return bUseOverlapSensor ? &OnSensorScanPaused : nullptr; }
+
+	/** @return True if the overlap sensor is in use and no push-capable actor is inside of it */
+	virtual bool IsPushPawnScanPaused() const override { return bUseOverlapSensor && SensorOverlaps.Num() == 0; }
 };
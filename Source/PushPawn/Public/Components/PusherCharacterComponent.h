@@ -0,0 +1,53 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PusherComponent.h"
+#include "GameplayTagContainer.h"
+#include "PusherCharacterComponent.generated.h"
+
+class UGameplayAbility;
+
+/**
+ * Native pusher for characters, configured entirely with properties
+ * Reads directly from CharacterOwner and its UCharacterMovementComponent, so no Blueprint VM calls are made while
+ * scanning or pushing. Prefer this over UPusherComponentHelper unless you need custom logic
+ */
+UCLASS(ClassGroup=(PushPawn), meta=(BlueprintSpawnableComponent))
+class PUSHPAWN_API UPusherCharacterComponent final
+	: public UPusherComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** The ability that defines how we push another pawn */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	TSubclassOf<UGameplayAbility> PushAbility;
+
+	/** Our owner's tags must match this query to push anyone at all, ignored if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	FGameplayTagQuery PushCapableTagQuery;
+
+	/** The pushee's tags must match this query for us to push them, ignored if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	FGameplayTagQuery CanPushTagQuery;
+
+	/** Scales how much we push others */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float StrengthScalar = 1.f;
+
+	/** If true, StrengthOverride replaces the calculated push strength */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	bool bOverrideStrength = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(EditCondition="bOverrideStrength", ClampMin="0", UIMin="0"))
+	float StrengthOverride = 0.f;
+
+public:
+	virtual void GatherPushOptions(const FPushQuery& PushQuery, FPushOptionBuilder& OptionBuilder) override;
+	virtual bool IsPushCapable() const override;
+	virtual bool CanPushPawn(const AActor* PusheeActor) const override;
+	virtual float GetPusherStrengthScalar() const override { return StrengthScalar; }
+	virtual bool GetPusherStrengthOverride(float& Strength) const override;
+};
@@ -15,6 +15,11 @@ class PUSHPAWN_API UPusherComponent
 {
 	GENERATED_BODY()
 
+public:
+	/** Categories we belong to and the categories we can push, e.g. change on team assignment */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn)
+	FPushPawnFilter PushFilter;
+
 public:
 	/** Fills OptionBuilder with FPushOption, which contains data such as the push ability and useful vectors */
 	virtual void GatherPushOptions(const FPushQuery& PushQuery, FPushOptionBuilder& OptionBuilder) override PURE_VIRTUAL(UPusherComponent::GatherPushOptions, ;);
@@ -32,6 +37,9 @@ public:
 	/** @return True if we can currently push the PusheeActor */
 	virtual bool CanPushPawn(const AActor* PusheeActor) const override PURE_VIRTUAL(UPusheeComponent::CanPushPawn, return false;);
 
+	/** @return Categories we belong to and the categories we can push */
+	virtual FPushPawnFilter GetPusherFilter() const override { return PushFilter; }
+
 	/** @return Optional runtime strength scaling to change how much the pusher pushes the pushee */
 	virtual float GetPusherStrengthScalar() const override { return 1.f; }
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "PushOption.h"
+#include "PushTypes.h"
 #include "IPush.generated.h"
 
 class IPusherTarget;
@@ -62,6 +63,12 @@ public:
 	/** @return True if we can currently be pushed by the PusherActor */
 	virtual bool CanBePushedBy(const AActor* PusherActor) const = 0;
 
+	/**
+	 * Evaluated before CanBePushedBy(), when candidates are found and before any push options are gathered
+	 * @return Categories we belong to and the categories that can push us
+	 */
+	virtual FPushPawnFilter GetPusheeFilter() const { return {}; }
+
 	/** @return Optional runtime strength scaling to change how much the pushee is pushed */
 	virtual float GetPusheeStrengthScalar() const { return 1.f; }
 
@@ -112,6 +119,12 @@ public:
 	 * @return Delegate for when the scan is paused or resumed
 	 */
 	virtual FOnPushPawnScanPaused* GetPushPawnScanPausedDelegate() { return nullptr; }
+
+	/**
+	 * Queried once when the scan binds to GetPushPawnScanPausedDelegate(), so the scan can start paused
+	 * @return True if the scan should currently be paused
+	 */
+	virtual bool IsPushPawnScanPaused() const { return false; }
 };
 
 /** Interface for the target who does the pushing */
@@ -143,6 +156,12 @@ public:
 	/** @return True if we can currently push the PusheeActor */
 	virtual bool CanPushPawn(const AActor* PusheeActor) const = 0;
 
+	/**
+	 * Evaluated before CanPushPawn(), when candidates are found and before any push options are gathered
+	 * @return Categories we belong to and the categories we can push
+	 */
+	virtual FPushPawnFilter GetPusherFilter() const { return {}; }
+
 	/** @return Optional runtime strength scaling to change how much the pusher pushes the pushee */
 	virtual float GetPusherStrengthScalar() const { return 1.f; }
 
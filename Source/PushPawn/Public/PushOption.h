@@ -52,14 +52,20 @@ struct PUSHPAWN_API FPushOption
 	UPROPERTY(BlueprintReadOnly, Category=PushPawn)
 	FGameplayAbilitySpecHandle TargetPushAbilityHandle;
 
-	FORCEINLINE bool operator==(const FPushOption& Other) const
+	/** @return True if both options refer to the same push, and neither location has moved further than LocationTolerance */
+	FORCEINLINE bool Equals(const FPushOption& Other, float LocationTolerance = UE_KINDA_SMALL_NUMBER) const
 	{
 		return PusherTarget == Other.PusherTarget &&
 			PushAbilityToGrant == Other.PushAbilityToGrant&&
 			TargetAbilitySystem == Other.TargetAbilitySystem &&
 			TargetPushAbilityHandle == Other.TargetPushAbilityHandle &&
-			PusheeActorLocation.Equals(Other.PusheeActorLocation) &&
-			PusherActorLocation.Equals(Other.PusherActorLocation);
+			PusheeActorLocation.Equals(Other.PusheeActorLocation, LocationTolerance) &&
+			PusherActorLocation.Equals(Other.PusherActorLocation, LocationTolerance);
+	}
+
+	FORCEINLINE bool operator==(const FPushOption& Other) const
+	{
+		return Equals(Other);
 	}
 
 	FORCEINLINE bool operator!=(const FPushOption& Other) const
@@ -0,0 +1,157 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+
+class UCharacterMovementComponent;
+
+#if !UE_BUILD_SHIPPING
+
+/** How p.PushPawn.Bench.Start moves every locally controlled pawn */
+enum class EPushPawnBenchScenario : uint8
+{
+	Converge,	// Towards the center of the crowd
+	Cross,		// Alternate pawns run past each other, reversing every few seconds
+	Orbit,		// Around the center of the crowd
+};
+
+/** Counters gathered while a benchmark is running, for a single world */
+struct PUSHPAWN_API FPushPawnBenchCounters
+{
+	int32 NetSyncs = 0;
+	int32 PushesTriggered = 0;
+
+	/** Pushes triggered by a predicting client, each of which is sent to the server */
+	int32 PushRPCs = 0;
+
+	int32 ClientPushesVerified = 0;
+	int32 ClientPushesRejected = 0;
+	int32 FallbackScans = 0;
+
+	/** Corrections sent by the server, polled from every UCharacterMovementComponent after moves are processed */
+	int32 CorrectionsSent = 0;
+
+	/** Corrections received by the client, and how far each moved us */
+	int32 Corrections = 0;
+	double CorrectionErrorSum = 0.0;
+	float MaxCorrectionError = 0.f;
+};
+
+/** The last correction seen on a movement component, so each is only counted once */
+struct FPushPawnBenchMovement
+{
+	float LastAdjustmentTimeStamp = 0.f;
+	float LastCorrectionTime = 0.f;
+
+	/** The last move the client saved, or the server processed */
+	float LastMoveTimeStamp = 0.f;
+};
+
+/** Where a client was after one of its moves, compared to the server once it has processed the same move */
+struct FPushPawnBenchMove
+{
+	float TimeStamp = 0.f;
+	FVector Location = FVector::ZeroVector;
+};
+
+/** A world measured by the benchmark */
+struct FPushPawnBenchWorld
+{
+	TWeakObjectPtr<UWorld> World;
+	FString Name;
+	FString NetMode;
+	FPushPawnBenchCounters Counters;
+
+	TMap<TObjectKey<UCharacterMovementComponent>, FPushPawnBenchMovement> Movements;
+
+	/** Where the crowd started, the scenarios move relative to it */
+	TOptional<FVector> Center;
+};
+
+/**
+ * Measures de-sync and network cost while driving scripted crowd movement, across every world in the process
+ * Run a listen or dedicated server with clients in a single process to also measure the position error between them
+ * Use with network emulation, e.g. -ExecCmds="Net PktLag=200, Net PktLoss=5, p.PushPawn.Bench.Start Converge 30"
+ * The PushPawn.Benchmark automation test runs every scenario under several emulation profiles in a play session
+ * Results are logged and written as JSON to Saved/PushPawn/
+ * Not available in shipping builds
+ */
+class PUSHPAWN_API FPushPawnBenchmark
+{
+public:
+	/** @return The counters for the world, or nullptr if no benchmark is running */
+	static FPushPawnBenchCounters* GetCounters(const UObject* WorldContextObject)
+	{
+		return Instance ? Instance->FindOrAddCounters(WorldContextObject) : nullptr;
+	}
+
+	static void Start(EPushPawnBenchScenario Scenario, float Duration);
+
+	/** Stop the running benchmark and report its results */
+	static void Stop();
+
+	static bool IsRunning() { return Instance.IsValid(); }
+
+	~FPushPawnBenchmark();
+
+private:
+	FPushPawnBenchmark(EPushPawnBenchScenario InScenario, float InDuration);
+
+	FPushPawnBenchCounters* FindOrAddCounters(const UObject* WorldContextObject);
+
+	FPushPawnBenchWorld& FindOrAddWorld(UWorld* World);
+
+	/** @return False once the duration has elapsed, we are stopped after the ticker has finished calling us */
+	bool Tick(float DeltaTime);
+
+	/** After actors have ticked, moves have been processed but corrections haven't been sent yet */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	/** Count the corrections sent and received by every character in the world */
+	void PollCorrections(FPushPawnBenchWorld& BenchWorld) const;
+
+	/**
+	 * Record the moves saved by each client, and compare each move the server has processed to the client's location
+	 * after that same move, so latency doesn't count towards the error
+	 */
+	void SampleMoves(FPushPawnBenchWorld& BenchWorld);
+
+	/** Add input to every locally controlled pawn in the world */
+	void DriveWorld(FPushPawnBenchWorld& BenchWorld, float Time) const;
+
+	/**
+	 * Compare the location of every player's pawn on each client to the server's at the same instant
+	 * This is mostly speed multiplied by latency, so it is reported separately from the position error
+	 */
+	void SampleLatencyOffset();
+
+	/** @return The results as JSON */
+	FString Report() const;
+
+	static TUniquePtr<FPushPawnBenchmark> Instance;
+
+	EPushPawnBenchScenario Scenario;
+	float Duration;
+	double StartTime;
+
+	TMap<TObjectKey<UWorld>, FPushPawnBenchWorld> Worlds;
+
+	/** Moves saved by clients in this process, keyed by player ID */
+	TMap<int32, TArray<FPushPawnBenchMove>> ClientMoves;
+
+	double PositionErrorSum = 0.0;
+	float MaxPositionError = 0.f;
+	int32 NumPositionErrorSamples = 0;
+
+	double LatencyOffsetSum = 0.0;
+	float MaxLatencyOffset = 0.f;
+	int32 NumLatencyOffsetSamples = 0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PostActorTickHandle;
+};
+
+#endif
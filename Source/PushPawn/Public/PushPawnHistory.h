@@ -0,0 +1,61 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Structure-of-arrays ring buffer of recent participant locations, recorded once per frame on authority
+ * Used to rewind a pusher to where the owning client saw it when verifying the client's pushes
+ * Every participant shares the same sample times, each participant's samples are contiguous
+ */
+struct PUSHPAWN_API FPushPawnHistory
+{
+public:
+	/** Discard everything and keep InCapacity samples per participant */
+	void Init(int32 InCapacity);
+
+	/** Start recording Actor, its history begins with the next sample */
+	void Add(const AActor* Actor);
+
+	/** Stop recording Actor, its row is reused by the next participant */
+	void Remove(const AActor* Actor);
+
+	/** Record the location of every participant at Time, which must be later than the previous sample */
+	void Record(double Time);
+
+	/**
+	 * Interpolate between the samples either side of Time, clamped to the oldest and newest samples
+	 * @return False if Actor isn't recorded or has no samples yet
+	 */
+	bool GetLocationAtTime(const AActor* Actor, double Time, FVector& OutLocation) const;
+
+	int32 Num() const { return Rows.Num(); }
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+	/** @return The slot of a participant's sample, where 0 is the oldest of NumValid samples */
+	int32 GetSlot(int32 Sample, int32 NumValid) const { return (Head - NumValid + Sample + Capacity) % Capacity; }
+
+	int32 Capacity = 0;
+
+	/** The slot the next sample is written to */
+	int32 Head = 0;
+
+	/** Per slot */
+	TArray<double> Times;
+
+	/** Per row, then per slot */
+	TArray<FVector> Locations;
+
+	/** Per row */
+	TArray<TWeakObjectPtr<const AActor>> Actors;
+	TArray<int32> NumSamples;
+
+	TArray<int32> FreeRows;
+	TMap<FObjectKey, int32> Rows;
+};
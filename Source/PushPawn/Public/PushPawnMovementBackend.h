@@ -0,0 +1,92 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PushPawnMovementBackend.generated.h"
+
+class UCurveFloat;
+
+/** A push force to apply to a movement component, see UPushPawnMovementBackend::ApplyPush() */
+struct PUSHPAWN_API FPushPawnForce
+{
+	/** Direction multiplied by strength */
+	FVector Force = FVector::ZeroVector;
+
+	float Duration = 0.f;
+
+	/** Optional, scales Force over the normalized duration */
+	TObjectPtr<UCurveFloat> StrengthOverTime = nullptr;
+
+	bool bIsAdditive = true;
+
+	/** Leave the vertical velocity to gravity */
+	bool bEnableGravity = true;
+};
+
+/**
+ * Applies push forces to a type of movement component
+ * Lets UAbilityTask_PushPawnForce and the push actions drive movement systems other than UCharacterMovementComponent
+ *
+ * Backends are stateless, they are used through their class default object
+ * Register them when their module starts up, backends registered later take precedence
+ */
+UCLASS(Abstract)
+class PUSHPAWN_API UPushPawnMovementBackend : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static void RegisterBackend(TSubclassOf<UPushPawnMovementBackend> BackendClass);
+	static void UnregisterBackend(TSubclassOf<UPushPawnMovementBackend> BackendClass);
+
+	/**
+	 * Find the backend that can push the avatar
+	 * @param Avatar				The pawn to push
+	 * @param OutMovementComponent	The movement component to pass to the backend
+	 * @return The backend, or nullptr if nothing can push the avatar
+	 */
+	static const UPushPawnMovementBackend* FindBackend(const AActor* Avatar, UActorComponent*& OutMovementComponent);
+
+	/** @return The movement component this backend can push on the avatar, if any */
+	virtual UActorComponent* FindMovementComponent(const AActor* Avatar) const { return nullptr; }
+
+	/** @return True if the movement component is in a state where it can be pushed right now */
+	virtual bool CanPush(const UActorComponent* MovementComponent) const { return IsValid(MovementComponent); }
+
+	/** @return ID of the applied push, or INDEX_NONE if it could not be applied */
+	virtual int32 ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const { return INDEX_NONE; }
+
+	/** Remove the push before it finishes, if the movement component allows it */
+	virtual void RemovePush(UActorComponent* MovementComponent, int32 PushID) const {}
+
+	/** @return True if the push is still being applied */
+	virtual bool IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const { return false; }
+
+	/**
+	 * @return True if the movement component predicts and reconciles pushes as part of its own simulation
+	 * The scan abilities don't need to wait for net syncs for these, corrections are handled by the simulation
+	 */
+	virtual bool IsPredictedByMovement() const { return false; }
+
+private:
+	static TArray<TSubclassOf<UPushPawnMovementBackend>> Backends;
+};
+
+/**
+ * Pushes UCharacterMovementComponent with a constant force root motion source
+ * Registered by default
+ */
+UCLASS()
+class PUSHPAWN_API UPushPawnMovementBackend_Character : public UPushPawnMovementBackend
+{
+	GENERATED_BODY()
+
+public:
+	virtual UActorComponent* FindMovementComponent(const AActor* Avatar) const override;
+	virtual bool CanPush(const UActorComponent* MovementComponent) const override;
+	virtual int32 ApplyPush(UActorComponent* MovementComponent, const FPushPawnForce& Force) const override;
+	virtual void RemovePush(UActorComponent* MovementComponent, int32 PushID) const override;
+	virtual bool IsPushActive(const UActorComponent* MovementComponent, int32 PushID) const override;
+};
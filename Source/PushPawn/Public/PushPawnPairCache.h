@@ -0,0 +1,81 @@
+// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class IPusheeInstigator;
+class IPusherTarget;
+
+enum class EPushPawnPairFlags : uint8
+{
+	None					= 0,
+	FirstPushChecked		= 1 << 0,	// FirstCanBePushed holds a result
+	FirstCanBePushed		= 1 << 1,	// First can be pushed by Second, and Second can push First
+	SecondPushChecked		= 1 << 2,	// SecondCanBePushed holds a result
+	SecondCanBePushed		= 1 << 3,	// Second can be pushed by First, and First can push Second
+	HasSeparation			= 1 << 4,
+};
+ENUM_CLASS_FLAGS(EPushPawnPairFlags);
+
+/**
+ * Results shared by both pawns of a pair
+ * First and Second are the actors in key order, not pushee and pusher
+ */
+struct PUSHPAWN_API FPushPawnPair
+{
+	/** Locations the separation was computed from */
+	FVector FirstLocation = FVector::ZeroVector;
+	FVector SecondLocation = FVector::ZeroVector;
+
+	/** SecondLocation - FirstLocation */
+	FVector Separation = FVector::ZeroVector;
+	float Distance = 0.f;
+	float Distance2D = 0.f;
+
+	/** Sum of both actors' simple collision radius, -1 if not yet computed */
+	float CombinedRadius = -1.f;
+
+	/** Permissions are not symmetric, so there is one bit per direction */
+	EPushPawnPairFlags Flags = EPushPawnPairFlags::None;
+};
+
+/**
+ * Per-frame cache keyed on the unordered actor pair
+ * Every pawn is both pushee and pusher, so A finds B and B finds A. The second side reuses the separation, distances,
+ * and combined radius computed by the first, and repeated pushes within the frame reuse the permission checks
+ * Cleared whenever the frame changes
+ */
+struct PUSHPAWN_API FPushPawnPairCache
+{
+public:
+	/** @return True if Pushee can be pushed by Pusher, and Pusher can push Pushee */
+	bool CanPush(const AActor* PusheeActor, const AActor* PusherActor, const IPusheeInstigator* Pushee,
+		const IPusherTarget* Pusher);
+
+	/**
+	 * @return PusheeLocation - PusherLocation
+	 * Recomputed if either location has changed since it was cached, e.g. a pawn moved between the two scans
+	 */
+	FVector GetSeparation(const AActor* PusheeActor, const AActor* PusherActor, const FVector& PusheeLocation,
+		const FVector& PusherLocation, float& OutDistance, float& OutDistance2D);
+
+	/** Cached equivalent of UPushStatics::GetNormalizedPushDistance() */
+	float GetNormalizedDistance(const AActor* PusheeActor, const AActor* PusherActor, float DistanceBetween);
+
+	int32 Num() const { return Pairs.Num(); }
+
+	SIZE_T GetAllocatedSize() const { return Pairs.GetAllocatedSize(); }
+
+	void Reset();
+
+protected:
+	/** @param bOutPusheeIsFirst True if Pushee is the pair's First actor */
+	FPushPawnPair& FindOrAdd(const AActor* PusheeActor, const AActor* PusherActor, bool& bOutPusheeIsFirst);
+
+	TMap<TPair<FObjectKey, FObjectKey>, FPushPawnPair> Pairs;
+
+	/** The frame the pairs were cached on */
+	uint64 CacheFrame = 0;
+};
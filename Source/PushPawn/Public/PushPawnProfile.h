@@ -0,0 +1,94 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "PushTypes.h"
+#include "PushPawnStrength.h"
+#include "PushPawnProfile.generated.h"
+
+class UCurveBase;
+class UCurveFloat;
+
+/**
+ * A float curve sampled at regular intervals across its key range
+ * Evaluation is clamped to the key range and linearly interpolated, so it only matches curves with constant extrapolation
+ */
+struct PUSHPAWN_API FPushPawnCurveLUT
+{
+	float MinTime = 0.f;
+	float InvStep = 0.f;
+	TArray<float> Samples;
+
+	/** Sample Curve NumSamples times, or clear the table if there is no curve */
+	void Bake(const UCurveFloat* Curve, int32 NumSamples);
+
+	bool IsBaked() const { return Samples.Num() > 0; }
+
+	/** @return The baked value at InTime, or Fallback's value if nothing was baked */
+	float Evaluate(float InTime, const UCurveFloat* Fallback) const;
+
+	/** @return The baked value at InTime, must be baked */
+	float Sample(float InTime) const
+	{
+		const float Position = FMath::Clamp((InTime - MinTime) * InvStep, 0.f, static_cast<float>(Samples.Num() - 1));
+		const int32 Index = FMath::FloorToInt32(Position);
+		const int32 NextIndex = FMath::Min(Index + 1, Samples.Num() - 1);
+		return FMath::Lerp(Samples[Index], Samples[NextIndex], Position - Index);
+	}
+};
+
+/**
+ * Scan and action parameters shared by every ability and task that references this profile, instead of each holding
+ * its own copy. Curves are baked into lookup tables on load
+ * Profiles are immutable at runtime
+ */
+UCLASS(BlueprintType)
+class PUSHPAWN_API UPushPawnProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	FPushPawnScanParams ScanParams;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	FPushPawnActionParams ActionParams;
+
+	/** Number of samples baked for each curve */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn, meta=(ClampMin="2", UIMin="2", UIMax="256"))
+	int32 CurveResolution = 64;
+
+	/** FPushPawnScanParams::RadiusVelocityScalar */
+	FPushPawnCurveLUT RadiusVelocityScalarLUT;
+
+	/** FPushPawnActionParams::VelocityToStrengthCurve */
+	FPushPawnCurveLUT VelocityToStrengthLUT;
+
+	/** FPushPawnActionParams::DistanceToStrengthCurve */
+	FPushPawnCurveLUT DistanceToStrengthLUT;
+
+	/** Evaluates ActionParams using the baked curves, bound along with them */
+	FPushPawnStrengthEvaluator StrengthEvaluator;
+
+public:
+	/** Sample every curve into its lookup table and bind StrengthEvaluator */
+	void BakeCurves();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void BeginDestroy() override;
+
+protected:
+	/** Re-bake when any referenced curve is edited, rebound whenever the referenced curves may have changed */
+	void BindCurveChanges();
+	void UnbindCurveChanges();
+	void OnCurveChanged(UCurveBase* Curve, EPropertyChangeType::Type ChangeType);
+
+	/** Curves we're bound to, so we can unbind from them if they're no longer referenced */
+	TArray<TWeakObjectPtr<UCurveBase>> BoundCurves;
+#endif
+};
@@ -0,0 +1,86 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "PushPawnRuleSet.generated.h"
+
+/** Whether pushers of one category can push pushees of another */
+USTRUCT(BlueprintType)
+struct PUSHPAWN_API FPushPawnRule
+{
+	GENERATED_BODY()
+
+	/** Category of the pusher, matches every category it is a parent of, or every category if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	FGameplayTag Pusher;
+
+	/** Category of the pushee, matches every category it is a parent of, or every category if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	FGameplayTag Pushee;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	bool bCanPush = true;
+};
+
+/**
+ * Push rules between tag categories, e.g. Heavy pushes Light, Ghost never pushes
+ * Compiled on load into a dense matrix indexed by category ID, so each pair is a single lookup
+ * Evaluated alongside IPusheeInstigator::CanBePushedBy() and IPusherTarget::CanPushPawn(), see UPushPawnSettings
+ */
+UCLASS(BlueprintType)
+class PUSHPAWN_API UPushPawnRuleSet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** ID of actors that have none of the categories */
+	static constexpr uint8 Uncategorized = 0;
+
+	/**
+	 * Actors belong to the first category they have a matching gameplay tag for, in order
+	 * Read from the actor's ability system component, or IGameplayTagAssetInterface
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	TArray<FGameplayTag> Categories;
+
+	/** Applied in order, later rules override earlier ones */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	TArray<FPushPawnRule> Rules;
+
+	/** Whether pairs that no rule applies to can push */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=PushPawn)
+	bool bCanPushByDefault = true;
+
+protected:
+	/** Row is the pusher's category ID, column is the pushee's */
+	TArray<bool> Matrix;
+
+	/** Number of category IDs, including Uncategorized */
+	int32 NumIDs = 0;
+
+public:
+	/** @return The ID of the first category found in Tags, or Uncategorized */
+	uint8 GetCategoryID(const FGameplayTagContainer& Tags) const;
+
+	/** @return True if a pusher of PusherID can push a pushee of PusheeID */
+	bool CanPush(uint8 PusherID, uint8 PusheeID) const
+	{
+		return PusherID < NumIDs && PusheeID < NumIDs ? Matrix[PusherID * NumIDs + PusheeID] : bCanPushByDefault;
+	}
+
+	/** Build the matrix from Categories and Rules */
+	void Compile();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	/** Calls Func with every category ID that Tag matches */
+	void ForEachMatchingID(const FGameplayTag& Tag, TFunctionRef<void(int32)> Func) const;
+};
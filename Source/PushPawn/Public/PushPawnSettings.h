@@ -0,0 +1,83 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "PushPawnSettings.generated.h"
+
+class UGameplayAbility;
+class UPushPawnRuleSet;
+
+/**
+ * Project settings for PushPawn
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Push Pawn"))
+class PUSHPAWN_API UPushPawnSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Optional push rules between tag categories, loaded by UPushPawnSubsystem */
+	UPROPERTY(Config, EditAnywhere, Category=PushPawn)
+	TSoftObjectPtr<UPushPawnRuleSet> RuleSet;
+
+	/**
+	 * Push abilities granted on authority to every pawn when its scan ability's avatar is set, in addition to
+	 * UPushPawn_Scan_Base::PushAbilitiesToPreGrant
+	 * Otherwise they are granted the first time a pawn touches a pusher, which hitches when a crowd first converges
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=PushPawn)
+	TArray<TSoftClassPtr<UGameplayAbility>> PreGrantedPushAbilities;
+
+	/** Pre-grants are spread across frames when many pawns spawn together, set to 0 to grant everything immediately */
+	UPROPERTY(Config, EditAnywhere, Category=PushPawn, meta=(ClampMin="0", UIMin="0"))
+	int32 MaxAbilityGrantsPerFrame = 16;
+
+	/**
+	 * If true, the server doesn't scan for remotely controlled pawns, their owning client already does
+	 * Pushes the client predicts are instead verified against the server's positions by UPushPawnSubsystem::VerifyClientPush()
+	 * The server only scans for them for FallbackScanDuration after a push fails verification, or the client net syncs
+	 * without having pushed
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification")
+	bool bVerifyClientPushes = false;
+
+	/** How far the server's distance between the pawns may differ from the client's, or exceed contact */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes", ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float VerifyDistanceTolerance = 50.f;
+
+	/** How far the client's push direction may differ from the direction between the pawns on the server */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes", ClampMin="0", UIMin="0", ClampMax="180", UIMax="180", ForceUnits="deg"))
+	float VerifyDirectionTolerance = 45.f;
+
+	/** Pushes predicted by a single client beyond this rate are rejected, set to 0 to disable */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes", ClampMin="0", UIMin="0"))
+	int32 MaxVerifiedPushesPerSecond = 20;
+
+	/** How long the server scans for a pawn itself after a push fails verification or the client net syncs without pushing */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes", ClampMin="0", UIMin="0", ForceUnits="s"))
+	float FallbackScanDuration = 2.f;
+
+	/**
+	 * Replicated event the client signals on its scan ability when it net syncs without having pushed
+	 * Kept apart from the regular net sync's GenericSignalFromClient, the scan ability must not use it for anything else
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes"))
+	TEnumAsByte<EAbilityGenericReplicatedEvent::Type> DeferralSignalEvent = EAbilityGenericReplicatedEvent::GameCustom1;
+
+	/**
+	 * Frames of participant locations kept by the server, so a pusher can be rewound to where the client saw it
+	 * Set to 0 to verify against current locations instead
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes", ClampMin="0", UIMin="0"))
+	int32 PositionHistorySamples = 32;
+
+	/** The furthest back a pusher is rewound, regardless of the client's ping */
+	UPROPERTY(Config, EditAnywhere, Category="Server Verification", meta=(EditCondition="bVerifyClientPushes", ClampMin="0", UIMin="0", ForceUnits="s"))
+	float MaxRewindTime = 0.3f;
+
+public:
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+};
@@ -0,0 +1,145 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionShape.h"
+#include "PushTypes.h"
+#include "UObject/ObjectKey.h"
+
+class UPushPawnRuleSet;
+
+enum class EPushPawnSnapshotFlags : uint8
+{
+	None				= 0,
+	Pushable			= 1 << 0,	// IPusheeInstigator::IsPushable()
+	PushCapable			= 1 << 1,	// IPusherTarget::IsPushCapable()
+	MovingOnGround		= 1 << 2,	// IPusheeInstigator::IsPusheeMovingOnGround()
+	Accelerating		= 1 << 3,	// UPushStatics::IsPusheeAccelerating()
+	PusheeOverride		= 1 << 4,	// IPusheeInstigator::GetPusheeStrengthOverride()
+	PusherOverride		= 1 << 5,	// IPusherTarget::GetPusherStrengthOverride()
+};
+ENUM_CLASS_FLAGS(EPushPawnSnapshotFlags);
+
+/**
+ * Structure-of-arrays snapshot of every registered participant's kinematic state
+ * Each participant is captured at most once per frame, so scans, pushes, and batched kernels read from here instead of
+ * calling through IPusheeInstigator and IPusherTarget repeatedly, which is a VM call for Blueprint implementations
+ */
+struct PUSHPAWN_API FPushPawnSnapshot
+{
+public:
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<FVector> Locations;
+	TArray<FQuat> Rotations;
+	TArray<FVector> Velocities;
+
+	/** Normalized, as returned by UPushStatics::GetPushPawnAcceleration() */
+	TArray<FVector> Accelerations;
+
+	/** From IPusheeInstigator::GetPusheeCollisionShape() */
+	TArray<FCollisionShape> Shapes;
+	TArray<FQuat> ShapeRotations;
+
+	TArray<EPushPawnSnapshotFlags> Flags;
+	TArray<float> PusheeStrengthScalars;
+	TArray<float> PusherStrengthScalars;
+	TArray<float> PusheeStrengthOverrides;
+	TArray<float> PusherStrengthOverrides;
+
+	/** From IPusheeInstigator::GetPusheeFilter() and IPusherTarget::GetPusherFilter() */
+	TArray<FPushPawnFilter> PusheeFilters;
+	TArray<FPushPawnFilter> PusherFilters;
+
+	/** UPushPawnRuleSet category IDs, kept up to date by UPushPawnSubsystem as tags change */
+	TArray<uint8> CategoryIDs;
+
+	/** Rule set the category IDs belong to, if any */
+	const UPushPawnRuleSet* RuleSet = nullptr;
+
+	/** The frame each participant was captured on */
+	TArray<uint64> CaptureFrames;
+
+public:
+	int32 Num() const { return Actors.Num(); }
+
+	/** @return The participant's index, capturing it first if it hasn't been captured this frame, or INDEX_NONE */
+	int32 FindOrCapture(const AActor* Actor);
+
+	/** Capture every participant that hasn't been captured this frame */
+	void CaptureAll();
+
+	bool HasFlag(int32 Index, EPushPawnSnapshotFlags Flag) const { return EnumHasAnyFlags(Flags[Index], Flag); }
+
+	/**
+	 * Thread-safe, the category IDs are only written on the game thread
+	 * @return True if the participant at PusherIndex passes the category filters and rules to push the one at PusheeIndex
+	 */
+	bool PassesPushFilter(int32 PusherIndex, int32 PusheeIndex) const;
+
+	/** @return The participant's index without capturing it, or INDEX_NONE */
+	int32 Find(const AActor* Actor) const
+	{
+		const int32* Index = Indices.Find(Actor);
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	/** Velocity with Z removed while not moving on the ground, see UPushStatics::GetPusheeGroundVelocity() */
+	FVector GetGroundVelocity(int32 Index) const;
+
+	/** Replace the participants, existing state except for the rule set is discarded */
+	void Rebuild(const TArray<const AActor*>& InActors);
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+	void Capture(int32 Index);
+
+	TMap<FObjectKey, int32> Indices;
+};
+
+/**
+ * Uniform grid over the X/Y locations of the snapshot's captured participants, used to find candidates without physics
+ * Cells must be at least as large as the largest query radius plus the largest participant radius
+ */
+struct PUSHPAWN_API FPushPawnGrid
+{
+public:
+	void Build(const FPushPawnSnapshot& Snapshot, float InCellSize);
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+	/** Calls Func with the snapshot row of every participant in the cells surrounding Location */
+	template<typename FunctorType>
+	void ForEachCandidate(const FVector& Location, FunctorType&& Func) const
+	{
+		const FIntPoint Cell = GetCell(Location);
+		for (int32 X = -1; X <= 1; X++)
+		{
+			for (int32 Y = -1; Y <= 1; Y++)
+			{
+				if (const TArray<int32>* Rows = Cells.Find(Cell + FIntPoint(X, Y)))
+				{
+					for (const int32 Row : *Rows)
+					{
+						Func(Row);
+					}
+				}
+			}
+		}
+	}
+
+	FIntPoint GetCell(const FVector& Location) const
+	{
+		return { FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize) };
+	}
+
+protected:
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	float CellSize = 1.f;
+};
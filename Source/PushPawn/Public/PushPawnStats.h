@@ -0,0 +1,86 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/** Every PushPawn allocation is tracked under this tag, run with -llm to view */
+LLM_DECLARE_TAG_API(PushPawn, PUSHPAWN_API);
+
+DECLARE_STATS_GROUP(TEXT("PushPawn"), STATGROUP_PushPawn, STATCAT_Advanced);
+
+/** Number of scans performed this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scans"), STAT_PushPawn_Scans, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of push abilities granted on first contact this frame, because they weren't pre-granted */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Lazy Ability Grants"), STAT_PushPawn_LazyGrants, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of times push options changed and were broadcast this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Option Changes"), STAT_PushPawn_OptionChanges, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of option changes ignored this frame because they were within FPushPawnScanParams::OptionLocationTolerance */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Option Changes Suppressed"), STAT_PushPawn_OptionChangesSuppressed, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of contacts kept this frame by FPushPawnScanParams::ContactExitDistance after the scan lost them */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Contacts Held"), STAT_PushPawn_ContactsHeld, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of pushes triggered this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pushes Triggered"), STAT_PushPawn_PushesTriggered, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of pushes dropped this frame because the same pusher pushed us within FPushPawnScanParams::MinPushInterval */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pushes Suppressed"), STAT_PushPawn_PushesSuppressed, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of results reused from the pair cache this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pair Cache Hits"), STAT_PushPawn_PairCacheHits, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of client predicted pushes the server verified this frame, see UPushPawnSettings::bVerifyClientPushes */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Client Pushes Verified"), STAT_PushPawn_ClientPushesVerified, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of client predicted pushes the server rejected this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Client Pushes Rejected"), STAT_PushPawn_ClientPushesRejected, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Number of times the server started scanning for a client's pawn itself this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fallback Scans"), STAT_PushPawn_FallbackScans, STATGROUP_PushPawn, PUSHPAWN_API);
+
+/** Bytes attributed to PushPawn, gathered by p.PushPawn.MemReport */
+struct PUSHPAWN_API FPushPawnMemoryUsage
+{
+	/** UPushPawn_Ability instances, excluding their containers */
+	int64 AbilityInstances = 0;
+
+	/** FGameplayAbilitySpec entries for PushPawn abilities */
+	int64 AbilitySpecs = 0;
+
+	int64 ScanTasks = 0;
+	int64 SyncTasks = 0;
+	int64 ForceTasks = 0;
+
+	/** Push option arrays held by scan abilities and tasks */
+	int64 Options = 0;
+
+	/** Cached maps, neighbor lists, snapshots, and other containers */
+	int64 Caches = 0;
+
+	/** Root motion sources applied by push actions */
+	int64 RootMotionSources = 0;
+
+	int64 GetTotal() const
+	{
+		return AbilityInstances + AbilitySpecs + ScanTasks + SyncTasks + ForceTasks + Options + Caches + RootMotionSources;
+	}
+
+	FPushPawnMemoryUsage& operator+=(const FPushPawnMemoryUsage& Other)
+	{
+		AbilityInstances += Other.AbilityInstances;
+		AbilitySpecs += Other.AbilitySpecs;
+		ScanTasks += Other.ScanTasks;
+		SyncTasks += Other.SyncTasks;
+		ForceTasks += Other.ForceTasks;
+		Options += Other.Options;
+		Caches += Other.Caches;
+		RootMotionSources += Other.RootMotionSources;
+		return *this;
+	}
+};
@@ -0,0 +1,85 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APawn;
+class UCurveFloat;
+struct FPushPawnActionParams;
+struct FPushPawnCurveLUT;
+
+/**
+ * Evaluates push strength from FPushPawnActionParams without re-checking which curves are in use on every push
+ * Bind() selects a specialization for the curves that are present (none, velocity, distance, or both, each either
+ * baked or not) and Evaluate() dispatches straight to it
+ * Overriding the strength is decided per push and short-circuits in Calculate() before dispatching
+ *
+ * Curves are not owned, the evaluator must be re-bound when the params change and must not outlive them
+ */
+struct PUSHPAWN_API FPushPawnStrengthEvaluator
+{
+public:
+	using FEvaluateFunc = float(*)(const FPushPawnStrengthEvaluator& Evaluator, const APawn* Pushee, float Distance);
+
+	/**
+	 * Select the specialization for Params
+	 * @param VelocityLUT Used instead of VelocityToStrengthCurve if baked
+	 * @param DistanceLUT Used instead of DistanceToStrengthCurve if baked
+	 */
+	void Bind(const FPushPawnActionParams& Params, const FPushPawnCurveLUT* VelocityLUT = nullptr,
+		const FPushPawnCurveLUT* DistanceLUT = nullptr);
+
+	/** Select the specialization for the given curves */
+	void Bind(float InStrengthScalar, const UCurveFloat* InVelocityCurve, const UCurveFloat* InDistanceCurve,
+		const FPushPawnCurveLUT* InVelocityLUT = nullptr, const FPushPawnCurveLUT* InDistanceLUT = nullptr);
+
+	bool IsBound() const { return Func != nullptr; }
+
+	/**
+	 * @param Distance The normalized distance between the pushee and pusher
+	 * @return The push strength, as UPushStatics::GetPushStrength()
+	 */
+	float Evaluate(const APawn* Pushee, float Distance) const
+	{
+#if !UE_BUILD_SHIPPING
+		// p.PushPawn.DisableVelocityScaling and p.PushPawn.DisableDistanceScaling change which specialization applies
+		if (BoundSerial != GetCVarSerial())
+		{
+			Rebind();
+		}
+#endif
+		return Func ? Func(*this, Pushee, Distance) : StrengthScalar;
+	}
+
+	/** @return The push strength, as UPushStatics::CalculatePushStrength() */
+	float Calculate(const APawn* Pushee, bool bOverrideStrength, float InStrengthScalar, float NormalizedDistance) const
+	{
+		if (bOverrideStrength)
+		{
+			return InStrengthScalar;
+		}
+		return Evaluate(Pushee, NormalizedDistance) * InStrengthScalar;
+	}
+
+private:
+	template<bool bVelocity, bool bDistance, bool bBaked>
+	static float EvaluatePolicy(const FPushPawnStrengthEvaluator& Evaluator, const APawn* Pushee, float Distance);
+
+	/** Select Func from the bound curves and the current CVars */
+	void Rebind() const;
+
+#if !UE_BUILD_SHIPPING
+	/** Incremented whenever a strength CVar changes */
+	static uint32 GetCVarSerial();
+	mutable uint32 BoundSerial = 0;
+#endif
+
+	mutable FEvaluateFunc Func = nullptr;
+
+	const UCurveFloat* VelocityCurve = nullptr;
+	const UCurveFloat* DistanceCurve = nullptr;
+	const FPushPawnCurveLUT* VelocityLUT = nullptr;
+	const FPushPawnCurveLUT* DistanceLUT = nullptr;
+	float StrengthScalar = 1.f;
+};
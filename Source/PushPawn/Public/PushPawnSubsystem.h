@@ -0,0 +1,273 @@
+﻿// Copyright (c) Jared Taylor. All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GameplayTagContainer.h"
+#include "PushPawnHistory.h"
+#include "PushPawnPairCache.h"
+#include "PushPawnSnapshot.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PushPawnSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UAbilityTask_PushPawnScan;
+class UGameplayAbility;
+class UPushPawnRuleSet;
+class UPushPawnSubsystem;
+struct FPushPawnScanContext;
+struct FPushPawnMemoryUsage;
+
+UENUM()
+enum class EPushPawnTickPhase : uint8
+{
+	Prepare		UMETA(ToolTip="Game thread, prepare due scans and capture the snapshot"),
+	Read		UMETA(ToolTip="Any thread, find candidates for every prepared scan"),
+	Commit		UMETA(ToolTip="Game thread, update push options and schedule the next scans"),
+};
+
+/**
+ * Runs one phase of the centralized scan batch
+ * Ticks after movement, so scans read this frame's positions
+ */
+USTRUCT()
+struct PUSHPAWN_API FPushPawnTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UPushPawnSubsystem* Subsystem = nullptr;
+
+	EPushPawnTickPhase Phase = EPushPawnTickPhase::Prepare;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+		const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPushPawnTickFunction> : public TStructOpsTypeTraitsBase2<FPushPawnTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/** Cached UPushPawnRuleSet category of an actor, updated when its tags change */
+struct FPushPawnCategoryEntry
+{
+	uint8 ID = 0;
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystem;
+	FDelegateHandle TagChangedHandle;
+};
+
+/** A push ability waiting to be granted */
+struct FPushPawnPendingGrant
+{
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystem;
+	TSubclassOf<UGameplayAbility> Ability;
+
+	bool operator==(const FPushPawnPendingGrant& Other) const
+	{
+		return AbilitySystem == Other.AbilitySystem && Ability == Other.Ability;
+	}
+};
+
+/** Client predicted pushes verified for a pushee within the current one second window */
+struct FPushPawnVerifyWindow
+{
+	double StartTime = 0.0;
+	int32 NumPushes = 0;
+};
+
+/** A centralized scan and the time it is due */
+struct FPushPawnScheduledScan
+{
+	TWeakObjectPtr<UAbilityTask_PushPawnScan> Scan;
+	double DueTime = 0.0;
+};
+
+/**
+ * World registry of PushPawn participants
+ * Allows participants to find and notify each other without performing any traces
+ * Also runs every scan using FPushPawnScanParams::bCentralizedScan from dedicated tick functions
+ */
+UCLASS()
+class PUSHPAWN_API UPushPawnSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	/** Active scans, keyed by their avatar actor */
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<UAbilityTask_PushPawnScan>> Scans;
+
+	/** Number of registered scans that are currently sleeping */
+	int32 NumSleepingScans = 0;
+
+	/** Kinematic state of every registered scan's avatar */
+	FPushPawnSnapshot Snapshot;
+
+	/** Registration has changed since the snapshot was built */
+	bool bSnapshotDirty = false;
+
+	/** Centralized scans waiting to be due */
+	TArray<FPushPawnScheduledScan> ScheduledScans;
+
+	/** Scans prepared this frame, and their state through each phase */
+	TArray<UAbilityTask_PushPawnScan*> BatchScans;
+	TArray<FPushPawnScanContext> BatchContexts;
+
+	/**
+	 * Swapped with Snapshot by the prepare phase, so the two are double buffered instead of copied
+	 * The read phase may run alongside game thread work that captures into Snapshot, so it only reads this buffer
+	 */
+	FPushPawnSnapshot BatchSnapshot;
+
+	/** Registration has changed since BatchSnapshot was built, it is rebuilt once swapped back in */
+	bool bBatchSnapshotDirty = false;
+
+	/** Broadphase for centralized scans, rebuilt each batch */
+	FPushPawnGrid Grid;
+
+	FPushPawnTickFunction PrepareTickFunction;
+	FPushPawnTickFunction ReadTickFunction;
+	FPushPawnTickFunction CommitTickFunction;
+
+	/** Loaded from UPushPawnSettings */
+	UPROPERTY(Transient)
+	TObjectPtr<UPushPawnRuleSet> RuleSet;
+
+	/** Rule set categories of every actor evaluated so far */
+	TMap<TObjectKey<AActor>, FPushPawnCategoryEntry> Categories;
+
+	/** Loaded from UPushPawnSettings::PreGrantedPushAbilities */
+	UPROPERTY(Transient)
+	TArray<TSubclassOf<UGameplayAbility>> PreGrantedPushAbilities;
+
+	/** Push abilities waiting to be granted, in order */
+	TArray<FPushPawnPendingGrant> PendingGrants;
+
+	/** Rate limit for client predicted pushes, keyed by pushee */
+	TMap<TObjectKey<AActor>, FPushPawnVerifyWindow> VerifyWindows;
+
+	/** Recent locations of every registered scan's avatar, only recorded on a server verifying client pushes */
+	FPushPawnHistory History;
+	bool bRecordHistory = false;
+
+	/** Results shared by both pawns of a pair, cleared each frame */
+	FPushPawnPairCache PairCache;
+
+public:
+	UPushPawnSubsystem();
+	virtual ~UPushPawnSubsystem() override;
+
+	static UPushPawnSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/** Register the scan belonging to Avatar so it can be found and woken by other participants */
+	void RegisterScan(const AActor* Avatar, UAbilityTask_PushPawnScan* Scan);
+	void UnregisterScan(const AActor* Avatar, const UAbilityTask_PushPawnScan* Scan);
+
+	/** @return The scan belonging to Avatar, if registered */
+	UAbilityTask_PushPawnScan* FindScan(const AActor* Avatar) const;
+
+	/** Notify the registry that a scan has started or stopped sleeping */
+	void SetScanSleeping(bool bIsSleeping);
+
+	/** Wake the scan belonging to Avatar if it is sleeping, e.g. because a pusher has come within range */
+	void WakeScan(const AActor* Avatar);
+
+	const UPushPawnRuleSet* GetRuleSet() const { return RuleSet; }
+
+	/** @return The actor's rule set category ID, cached until its tags change */
+	uint8 GetPushCategory(const AActor* Actor);
+
+	/** @return True if the rule set allows Pusher to push Pushee, or there is no rule set */
+	bool PassesPushRules(const AActor* Pusher, const AActor* Pushee);
+
+	/**
+	 * Authority, cheaply check a push predicted by Pushee's owning client against our own positions, instead of scanning
+	 * Checks the rules, the rate limit, the distance between the pawns against Pushee's largest scan shape, and the push direction
+	 * A failed push starts a fallback scan for Pushee, see UPushPawnSettings::bVerifyClientPushes
+	 * @return True if the push is plausible, or verification is disabled
+	 */
+	bool VerifyClientPush(const AActor* Pushee, const AActor* Pusher, const FVector& Direction, float Distance, bool bDistance2D);
+
+	/**
+	 * Where Actor was when the client controlling Viewer last saw it, rewound by the client's ping
+	 * @return The current location if no history is recorded for Actor
+	 */
+	FVector GetRewoundLocation(const AActor* Actor, const AActor* Viewer) const;
+
+	const FPushPawnHistory& GetHistory() const { return History; }
+
+	FPushPawnPairCache& GetPairCache() { return PairCache; }
+
+	/**
+	 * Grant push abilities ahead of time on authority, so they don't need to be granted on first contact
+	 * Grants are batched across frames, see UPushPawnSettings::MaxAbilityGrantsPerFrame
+	 * @param Abilities Granted along with UPushPawnSettings::PreGrantedPushAbilities
+	 * @param bImmediate Grant now instead of waiting for the batch
+	 */
+	UFUNCTION(BlueprintCallable, Category=PushPawn)
+	void PreGrantPushAbilities(UAbilitySystemComponent* AbilitySystem, const TArray<TSubclassOf<UGameplayAbility>>& Abilities,
+		bool bImmediate = false);
+
+	/** Grant the ability unless AbilitySystem already has it */
+	static void GrantPushAbility(UAbilitySystemComponent* AbilitySystem, TSubclassOf<UGameplayAbility> Ability);
+
+	/** Run a centralized scan from the first batch after Delay has passed, replacing any pending schedule */
+	void ScheduleScan(UAbilityTask_PushPawnScan* Scan, float Delay);
+
+	/** Remove a centralized scan from the schedule, e.g. because it was paused */
+	void UnscheduleScan(const UAbilityTask_PushPawnScan* Scan);
+
+	/**
+	 * Participants are captured on first access each frame, after movement has ticked
+	 * @return The snapshot of every registered scan's avatar
+	 */
+	FPushPawnSnapshot& GetSnapshot();
+
+	/** Game thread, grant as many pending push abilities as the budget allows */
+	void ProcessPendingGrants();
+
+	/** Game thread, prepare every due scan, capture the snapshot and build the grid */
+	void PrepareScans();
+
+	/** Any thread, find candidates for every prepared scan */
+	void ReadScans();
+
+	/** Game thread, commit every prepared scan */
+	void CommitScans();
+
+	/** Add the memory held by the registry, snapshots, caches, and schedules to Usage */
+	void AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const;
+
+	/** Log PushPawn memory per pawn and in total for World, bound to p.PushPawn.MemReport */
+	static void ReportMemory(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Enable our tick functions only while scans are registered or abilities are waiting to be granted */
+	void UpdateTickFunctions();
+
+	/** Centralized scans don't tick until their avatar's movement has */
+	void AddMovementPrerequisite(const AActor* Avatar);
+	void RemoveMovementPrerequisite(const AActor* Avatar);
+
+	uint8 ComputePushCategory(const AActor* Actor, const UAbilitySystemComponent* AbilitySystem) const;
+
+	void OnCategoryTagChanged(const FGameplayTag Tag, int32 NewCount, TWeakObjectPtr<AActor> WeakActor);
+
+	UFUNCTION()
+	void OnCategoryActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	void RemovePushCategory(const AActor* Actor);
+};
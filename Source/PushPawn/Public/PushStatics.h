@@ -14,10 +14,12 @@ struct FGameplayAbilityTargetDataHandle;
 struct FPushPawnAbilityTargetData;
 struct FOverlapResult;
 struct FHitResult;
+struct FGameplayTagQuery;
 class UGameplayAbility;
 class FPushOptionBuilder;
 class IPusheeInstigator;
 class IPusherTarget;
+class UPushPawnProfile;
 
 /**
  * Static helper functions for PushPawn
@@ -127,6 +129,29 @@ public:
 	static float CalculatePushStrength(const APawn* Pushee, bool bOverrideStrength, float StrengthScalar,
 		float NormalizedDistance, const FPushPawnActionParams& Params);
 
+	/** 
+	 * Returns the push strength based on the profile's action parameters, using its pre-baked curves
+	 * @param Pushee	The pawn being pushed
+	 * @param Distance	The normalized distance between the pushee and pusher
+	 * @param Profile	The shared profile to evaluate
+	 * @return The push strength
+	 */
+	UFUNCTION(BlueprintPure, Category=PushPawn)
+	static float GetPushStrengthFromProfile(const APawn* Pushee, float Distance, const UPushPawnProfile* Profile);
+
+	/** 
+	 * Returns the push strength based on the profile's action parameters, using its pre-baked curves
+	 * @param Pushee				The pawn being pushed
+	 * @param bOverrideStrength		Whether to override the strength calculation
+	 * @param StrengthScalar		The scalar to apply to the push strength
+	 * @param NormalizedDistance	The normalized distance between the pushee and pusher
+	 * @param Profile				The shared profile to evaluate
+	 * @return The push strength
+	 */
+	UFUNCTION(BlueprintPure, Category=PushPawn)
+	static float CalculatePushStrengthFromProfile(const APawn* Pushee, bool bOverrideStrength, float StrengthScalar,
+		float NormalizedDistance, const UPushPawnProfile* Profile);
+
 	
 	/** 
 	 * Returns the push strength based on the push parameters
@@ -165,6 +190,15 @@ public:
 	static const IPusheeInstigator* GetPusheeInstigator(const AActor* Actor);
 	static IPusherTarget* GetPusherTarget(AActor* Actor);
 	static const IPusherTarget* GetPusherTarget(const AActor* Actor);
+
+	/** @return True if the category filters allow Pusher to push Pushee, checked before any push options are gathered */
+	static bool PassesPushFilter(const IPusherTarget* Pusher, const IPusheeInstigator* Pushee);
+
+	/**
+	 * Natively read the actor's owned tags from its ability system component, or IGameplayTagAssetInterface
+	 * @return True if the query is empty or matches, false if it can't be evaluated
+	 */
+	static bool MatchesTagQuery(const AActor* Actor, const FGameplayTagQuery& Query);
 	
 	static FVector GetPushPawnAcceleration(const IPusheeInstigator* Pushee);
 	static FVector GetPushPawnAcceleration(APawn* Pushee);
@@ -180,6 +214,46 @@ public:
 	static float GetPushPawnScanRange(APawn* Pushee, float BaseScanRange, const FPushPawnScanParams& ScanParams);
 	static float GetPushPawnScanRange(const FVector& Acceleration, float BaseScanRange, const FPushPawnScanParams& ScanParams);
 
+	/**
+	 * Time until two bodies make contact, assuming both maintain their current velocity
+	 * @param bIs2D		If true, only X/Y are considered
+	 * @return Seconds until contact, 0 if already in contact, or -1 if they will never make contact
+	 */
+	static float GetTimeToContact(const FVector& LocationA, const FVector& VelocityA, float RadiusA,
+		const FVector& LocationB, const FVector& VelocityB, float RadiusB, bool bIs2D);
+
+	/**
+	 * Analytic overlap test between two Capsule, Sphere, or Box shapes, without going through physics
+	 * Capsules and spheres are exact. Boxes are exact against a point, approximate against a segment, and a box
+	 * against a box tests the bounding sphere of A
+	 * @param bIs2D					If true, shapes are tested as circles on X/Y and must overlap vertically
+	 * @param OutPenetrationDepth	How far the shapes overlap, zero if not overlapping
+	 * @param OutNormal				Contact normal pointing from B towards A, zero if not overlapping
+	 * @return True if the shapes overlap, false if they don't or either shape isn't supported
+	 */
+	static bool ComputeShapeOverlap(const FCollisionShape& ShapeA, const FVector& LocationA, const FQuat& RotationA,
+		const FCollisionShape& ShapeB, const FVector& LocationB, const FQuat& RotationB, bool bIs2D,
+		float& OutPenetrationDepth, FVector& OutNormal);
+
+	/**
+	 * Test a circle against 4 candidate circles on X/Y at once, candidates must also overlap vertically
+	 * Unused lanes can be filled with a negative radius
+	 * Lanes are single precision, far from the world origin pass a zero Location and candidates relative to us
+	 * @param OutPenetrationDepth	Penetration depth per candidate, negative if not overlapping
+	 */
+	static void ComputeCircleOverlap4(const FVector& Location, float Radius, float HalfHeight,
+		const float* CandidateX, const float* CandidateY, const float* CandidateZ, const float* CandidateRadius,
+		const float* CandidateHalfHeight, float* OutPenetrationDepth);
+
+	/** @return True if the shape can be tested by ComputeShapeOverlap() */
+	static bool SupportsAnalyticOverlap(const FCollisionShape& Shape);
+
+	/** @return Radius of the shape on X/Y, boxes use their footprint's half diagonal */
+	static float GetShapeRadius2D(const FCollisionShape& Shape);
+
+	/** @return Radius on X/Y of the actor's IPusheeInstigator::GetPusheeCollisionShape(), or its simple collision radius */
+	static float GetPusheeRadius2D(const AActor* Actor);
+
 	/** Default implementation of IPusherTarget::GatherPushOptions for convenience */
 	static bool GatherPushOptions(const TSubclassOf<UGameplayAbility>& PushAbilityToGrant, const APawn* PusherPawn,
 		const FPushQuery& PushQuery, const FPushOptionBuilder& OptionBuilder);
@@ -220,6 +294,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category=PushPawn)
 	static void GetPushTargetsFromActor(AActor* Actor, TArray<TScriptInterface<IPusherTarget>>& OutPushTargets);
 
+	/**
+	 * Gives the actor's root component its pusher categories as a mask filter, so scans using
+	 * FPushPawnScanParams::bApplyMaskFilter can skip it in physics. Call again when the categories change
+	 * @param Actor The pusher, must implement IPusherTarget or have a UPusherComponent
+	 */
+	UFUNCTION(BlueprintCallable, Category=PushPawn)
+	static void ApplyPushFilterToBody(AActor* Actor);
+
 public:
 	/** 
 	 * Appends push targets from the given overlap results to the output array.
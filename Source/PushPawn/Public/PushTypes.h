@@ -68,6 +68,44 @@ enum class EPushPawnOverrideHandling : uint8
 	Average			UMETA(ToolTip="When both Pusher and Pushee want to override, average the results"),
 };
 
+/**
+ * Category bitmasks evaluated before any trace results are turned into push options, e.g. team, faction, ghosts, mounted
+ * The meaning of each bit is up to the project, by default everyone can push everyone
+ */
+USTRUCT(BlueprintType)
+struct PUSHPAWN_API FPushPawnFilter
+{
+	GENERATED_BODY()
+
+	/** Categories we belong to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(Bitmask))
+	int32 Categories = -1;
+
+	/** Categories that can push us */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(Bitmask))
+	int32 CanBePushedByMask = -1;
+
+	/** Categories we can push */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=PushPawn, meta=(Bitmask))
+	int32 CanPushMask = -1;
+
+	/** @return True if a pusher with this filter may push a pushee with PusheeFilter */
+	bool CanPush(const FPushPawnFilter& PusheeFilter) const
+	{
+		return (Categories & PusheeFilter.CanBePushedByMask) != 0 && (PusheeFilter.Categories & CanPushMask) != 0;
+	}
+
+	/** @return Our categories that fit in FMaskFilter, for the body instance of our collision */
+	uint8 GetBodyMaskFilter() const;
+
+	/**
+	 * FMaskFilter ignores a body that shares any bit with the query, so a body is skipped if any of its categories can't
+	 * push us, even if another one can
+	 * @return Categories that can't push us that fit in FMaskFilter, for FCollisionQueryParams::IgnoreMask
+	 */
+	uint8 GetQueryIgnoreMask() const;
+};
+
 /**
  * Customize the behavior of the pawn when it is pushed
  */
@@ -151,6 +189,121 @@ struct PUSHPAWN_API FPushPawnScanParams
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(ClampMin="0", UIMin="0", Delta="0.1", ForceUnits="s"))
 	float ScanRateAccel;
 
+	/**
+	 * The shortest interval allowed when the next scan is brought forward, e.g. to land on a predicted contact
+	 * Prevents a scan from being scheduled every frame
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(ClampMin="0.001", UIMin="0.001", Delta="0.01", ForceUnits="s"))
+	float MinScanInterval;
+
+	/**
+	 * If true, the scan shape is swept along our velocity for the duration of the next scan interval instead of
+	 * testing only our current position. The earliest contact and its time of impact are reported, and the next scan
+	 * is brought forward to the time of impact, so lower scan rates can be used without missing or delaying pushes
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	bool bPredictiveScan;
+
+	/** Scales the predictive sweep length, which is velocity * scan interval */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(EditCondition="bPredictiveScan", ClampMin="0", UIMin="0", Delta="0.1", ForceUnits="x"))
+	float PredictiveScanTimeScalar;
+
+	/**
+	 * If true, ScanRate and ScanRateAccel are ignored. After each scan the time-to-contact with the nearest candidate
+	 * is computed from relative velocities and separation, and the next scan is scheduled at that time
+	 * Clamped between MinScanInterval and MaxScanInterval, and no later than the regular scan rate while anything is in range
+	 * Candidates come from the neighbor list, which is always used with this and covers MaxClosingSpeed over MaxScanInterval
+	 * Centralized scans find them from the grid instead, see bCentralizedScan
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	bool bTimeToContactScheduling;
+
+	/** The longest interval between scans when using time-to-contact scheduling, used when nothing is closing on us */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(EditCondition="bTimeToContactScheduling", ClampMin="0.001", UIMin="0.001", Delta="0.1", ForceUnits="s"))
+	float MaxScanInterval;
+
+	/**
+	 * The fastest two pawns are expected to close on each other
+	 * Candidates are searched for within the distance that can be closed at this speed over MaxScanInterval
+	 * Also bounds how long the neighbor list is trusted before it is rebuilt
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(EditCondition="bTimeToContactScheduling || bUseNeighborList", ClampMin="0", UIMin="0", Delta="10", ForceUnits="cm/s"))
+	float MaxClosingSpeed;
+
+	/**
+	 * If true, the scan stops after SleepDelay has passed without any velocity, acceleration, or push options
+	 * It wakes when we start moving, or when a nearby pusher finds us
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	bool bAllowSleep;
+
+	/** How long the pawn must be stationary and uncontested before the scan sleeps */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(EditCondition="bAllowSleep", ClampMin="0", UIMin="0", Delta="0.1", ForceUnits="s"))
+	float SleepDelay;
+
+	/** How often a sleeping scan checks our velocity and acceleration to wake up, this does not perform a trace */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(EditCondition="bAllowSleep", ClampMin="0.01", UIMin="0.01", Delta="0.1", ForceUnits="s"))
+	float SleepWakeCheckRate;
+
+	/**
+	 * If true, candidates within the scan range plus NeighborSkin are cached, and following scans test only the cached
+	 * candidates with an analytic distance check instead of a trace
+	 * The list is rebuilt once we or any neighbor has moved more than half of NeighborSkin, or once a pawn outside the
+	 * list could have closed NeighborSkin at MaxClosingSpeed
+	 * A larger NeighborSkin rebuilds less often, at the cost of a larger overlap
+	 * Not used while a predictive sweep is in progress
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	bool bUseNeighborList;
+
+	/** Margin added to the scan range when building the neighbor list */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn, meta=(EditCondition="bUseNeighborList", ClampMin="1", UIMin="1", Delta="1", ForceUnits="cm"))
+	float NeighborSkin;
+
+	/**
+	 * If true, scans are batched by UPushPawnSubsystem instead of tracing individually
+	 * Batches run from the subsystem's tick functions after the avatar's movement has ticked, instead of from a timer
+	 * Candidates are found from the participant snapshot using a uniform grid and the analytic narrowphase, spread
+	 * across worker threads, then push options are committed on the game thread
+	 * Only participants with a registered scan can be found. bPredictiveScan and bUseNeighborList are not used, and
+	 * time-to-contact is found from the grid on the worker threads
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	bool bCentralizedScan;
+
+	/**
+	 * If true, our physics queries use FCollisionQueryParams::IgnoreMask to skip bodies whose categories can't push us,
+	 * and our avatar's root component is given our categories as its mask filter when the scan starts
+	 * Only the lowest 6 categories are supported by FMaskFilter, pushers without a scan must call
+	 * UPushStatics::ApplyPushFilterToBody() themselves
+	 * @see FPushPawnFilter
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
+	bool bApplyMaskFilter;
+
+	/**
+	 * Push options are only considered changed once either location has moved further than this since the last scan,
+	 * small jitter while in contact won't re-trigger the push, but the locations are still kept current
+	 * Set to 0 to disable
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="PushPawn|Hysteresis", meta=(ClampMin="0", UIMin="0", Delta="0.1", ForceUnits="cm"))
+	float OptionLocationTolerance;
+
+	/**
+	 * Minimum time before the same pusher can push us again, pushes inside this window are retried once it has elapsed
+	 * Set to 0 to disable
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="PushPawn|Hysteresis", meta=(ClampMin="0", UIMin="0", Delta="0.05", ForceUnits="s"))
+	float MinPushInterval;
+
+	/**
+	 * Once in contact, a pusher is kept until the gap between our collision radii exceeds this, even if the scan no
+	 * longer finds it, so pawns at the edge of the scan range don't flicker in and out of contact
+	 * Set to 0 to disable
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="PushPawn|Hysteresis", meta=(ClampMin="0", UIMin="0", Delta="1", ForceUnits="cm"))
+	float ContactExitDistance;
+
 	/** How to handle multiple strength overrides */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=PushPawn)
 	EPushPawnOverrideHandling StrengthOverrideHandling;
@@ -6,7 +6,7 @@
 #include "Abilities/Tasks/AbilityTask.h"
 #include "AbilityTask_PushPawnForce.generated.h"
 
-class UCharacterMovementComponent;
+class UPushPawnMovementBackend;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FApplyPushPawnForceDelegate);
 
 /**
@@ -15,6 +15,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FApplyPushPawnForceDelegate);
  *
  * It does not replicate anything
  *	Because it is local predicted and originates from CMC, it is not necessary to replicate
+ *
+ * The force is applied by the UPushPawnMovementBackend registered for the avatar's movement component
  */
 UCLASS()
 class PUSHPAWN_API UAbilityTask_PushPawnForce : public UAbilityTask
@@ -66,7 +68,11 @@ public:
 	
 protected:
 	UPROPERTY()
-	TObjectPtr<UCharacterMovementComponent> MovementComponent; 
+	TObjectPtr<UActorComponent> MovementComponent;
+
+	/** Applies the force to MovementComponent */
+	UPROPERTY()
+	TObjectPtr<const UPushPawnMovementBackend> MovementBackend;
 	
 protected:
 	UPROPERTY()
@@ -87,7 +93,8 @@ protected:
 	UPROPERTY()
 	bool bEnableGravity;
 	
-	uint16 RootMotionSourceID;
+	/** ID returned by MovementBackend, INDEX_NONE if not applied */
+	int32 PushID;
 
 public:
 	FTimerHandle FinishTimerHandle;
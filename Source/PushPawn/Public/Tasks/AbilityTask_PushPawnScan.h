@@ -5,9 +5,74 @@
 #include "CoreMinimal.h"
 #include "AbilityTask_PushPawnScan_Base.h"
 #include "PushTypes.h"
+#include "CollisionShape.h"
 #include "AbilityTask_PushPawnScan.generated.h"
 
 class UAbilityTask_PushPawnSync;
+class UPushPawnProfile;
+struct FCollisionQueryParams;
+struct FPushPawnSnapshot;
+struct FPushPawnGrid;
+
+/** A candidate cached by the scan's neighbor list */
+struct FPushPawnNeighbor
+{
+	TWeakObjectPtr<AActor> Actor;
+
+	/** Tested with physics when the neighbor's shape can't be tested analytically */
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	/** Location when the list was built */
+	FVector Location = FVector::ZeroVector;
+
+	/** From IPusheeInstigator::GetPusheeCollisionShape() */
+	FCollisionShape Shape;
+
+	/** Shape rotation relative to the actor */
+	FQuat ShapeRotation = FQuat::Identity;
+
+	/** If true, Shape is tested with UPushStatics::ComputeShapeOverlap() */
+	bool bAnalytic = false;
+};
+
+/** State of a single scan, carried from the prepare phase through the read phase to the commit phase */
+struct FPushPawnScanContext
+{
+	AActor* AvatarActor = nullptr;
+
+	FVector Location = FVector::ZeroVector;
+	FVector TraceEnd = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+
+	/** Normalized */
+	FVector Acceleration = FVector::ZeroVector;
+	bool bHasAcceleration = false;
+
+	/** Our collision shape, scaled for scanning */
+	FCollisionShape Shape;
+	FQuat ShapeRotation = FQuat::Identity;
+
+	/** Scalar applied to the radius of Shape from our speed and acceleration */
+	float ShapeScalar = 1.f;
+
+	/** Our row in FPushPawnSnapshot */
+	int32 SnapshotIndex = INDEX_NONE;
+
+	/** Result of the read phase */
+	FHitResult Hit;
+
+	/** Row in FPushPawnSnapshot of the candidate found by a centralized scan */
+	int32 CandidateIndex = INDEX_NONE;
+
+	/** Resolved from CandidateIndex on the game thread before committing */
+	TWeakObjectPtr<AActor> CandidateActor;
+
+	/** Seconds until the earliest candidate reaches Shape, 0 if one already has, -1 if none can before MaxScanInterval */
+	float TimeToContact = -1.f;
+
+	/** Rows in FPushPawnSnapshot of candidates a centralized scan found closing on us, woken before committing */
+	TArray<int32, TInlineAllocator<4>> ClosingIndices;
+};
 
 /**
  * Implemented by the PushPawn Scan ability.
@@ -26,6 +91,13 @@ class PUSHPAWN_API UAbilityTask_PushPawnScan : public UAbilityTask_PushPawnScan_
 public:
 	UFUNCTION()
 	void OnNetSync(UAbilityTask_PushPawnSync* SyncPoint);
+
+	/**
+	 * Authority, the owning client net synced without having pushed while we were deferring to it
+	 * @see UPushPawnSettings::DeferralSignalEvent
+	 */
+	UFUNCTION()
+	void OnClientDeferralSignal(UAbilityTask_PushPawnSync* SyncPoint);
 	
 	void ActivateTimer(EPushPawnPauseType PauseType = EPushPawnPauseType::NotPaused);
 
@@ -45,15 +117,161 @@ public:
 		FGameplayAbilityTargetingLocationInfo StartLocation, const FPushPawnScanParams& ScanParams,
 		float ActivationFailureDelay = 0.2f);
 
+	/**
+	 * Wait until we trace new set of Pushes. This task automatically loops.
+	 * Reads the scan parameters from the profile instead of copying them
+	 * @param OwningAbility The ability that owns this task
+	 * @param PushQuery The query to use for the trace
+	 * @param StartLocation The location to start the trace from
+	 * @param Profile The shared profile to scan with, the default parameters are used if none is provided
+	 * @param ActivationFailureDelay The delay to wait before activating the ability again if the scan fails to activate due to invalid data
+	 */
+	UFUNCTION(BlueprintCallable, Category="Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+	static UAbilityTask_PushPawnScan* PushPawnScanWithProfile(
+		UGameplayAbility* OwningAbility, FPushQuery PushQuery,
+		FGameplayAbilityTargetingLocationInfo StartLocation, const UPushPawnProfile* Profile,
+		float ActivationFailureDelay = 0.2f);
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/** @return The earliest contact found by the last predictive scan, if any */
+	const FHitResult& GetPredictedContact() const { return PredictedContact; }
+
+	/** @return Seconds until the earliest predicted contact, or -1 if there is none */
+	float GetPredictedTimeOfImpact() const { return PredictedTimeOfImpact; }
+
+	/** @return True if the scan is sleeping because the pawn is stationary and uncontested */
+	bool IsSleeping() const { return bSleeping; }
+
+	/** Wake the scan if it is sleeping */
+	void WakeUp();
+
+	/** @return True if the server isn't scanning because the owning client's pushes are verified instead */
+	bool IsDeferredToClient() const { return bDeferredToClient; }
+
+	/**
+	 * Authority, scan for Duration even though the owning client is scanning for us
+	 * @see UPushPawnSettings::bVerifyClientPushes
+	 */
+	void BeginFallbackScan(float Duration);
+
+	/**
+	 * @return The furthest Pusher can be from us while our scan still finds it, at the largest shape scalar our scan
+	 * params allow the client to have scanned with, plus the contact exit band
+	 */
+	float GetMaxContactDistance(const AActor* Pusher) const;
+
+	/**
+	 * Game thread, gather everything the read phase needs
+	 * @return False if the scan can't run, the next scan has already been scheduled
+	 */
+	bool PrepareScan(FPushPawnScanContext& Context);
+
+	/**
+	 * Any thread, find the most deeply penetrating candidate using only the snapshot
+	 * Also finds the time-to-contact with every candidate when using time-to-contact scheduling
+	 */
+	void ExecuteCentralizedScan(FPushPawnScanContext& Context, const FPushPawnSnapshot& Snapshot,
+		const FPushPawnGrid& Grid) const;
+
+	/** Game thread, update the push options and schedule the next scan */
+	void CommitScan(FPushPawnScanContext& Context);
+
+	const FPushPawnScanParams& GetScanParams() const { return *ScanParams; }
+
+	virtual void AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const override;
+
+	/** @return The shared profile we're scanning with, if any */
+	const UPushPawnProfile* GetProfile() const { return Profile; }
+
 private:
 	virtual void OnDestroy(bool bInOwnerFinished) override;
 
 	void PerformTrace();
 
+	/** Game thread, find candidates with physics */
+	void ExecuteScan(FPushPawnScanContext& Context);
+
+	FCollisionQueryParams MakeQueryParams(const AActor* AvatarActor) const;
+
+	/** Register so nearby pushers can find and wake us */
+	void RegisterWithSubsystem(AActor* AvatarActor, const UWorld* World);
+
+	/** @return True if we're the server for a remotely controlled pawn that should rely on verifying its client's pushes */
+	bool ShouldDeferToClient() const;
+
+	/** Stop scanning until a client push fails verification or the client net syncs without pushing */
+	void DeferToClient();
+
+	/** Predicting client, tell a server deferring to us that we net synced without pushing, so it can check */
+	void SignalDeferral();
+
+	/**
+	 * Schedule the next scan based on the time-to-contact between our scan shape and the nearest neighbor
+	 * Falls back to the regular scan rate while anything is already in range
+	 */
+	void UpdateTimeToContact(FPushPawnScanContext& Context);
+
+	/**
+	 * Fold the time-to-contact with every neighbor into Context, and wake any that can reach us before our next scan
+	 * @return How long pawns outside the neighbor list are guaranteed not to reach us
+	 */
+	float FindNeighborTimeToContact(FPushPawnScanContext& Context);
+
+	/** @return NeighborSkin, widened to what can close on us over MaxScanInterval when using time-to-contact scheduling */
+	float GetNeighborSkin() const;
+
 	void OnScanPaused(bool bIsPaused);
+
+	/** Bound to IPusheeInstigator::GetPushPawnScanPausedDelegate() */
+	void OnExternalScanPaused(bool bIsPaused);
+
+	/** Stop scanning until we move or a nearby pusher wakes us */
+	void Sleep();
+
+	/** Cheaply check if the pawn has started moving while asleep */
+	void CheckWake();
+
+	/** Wake any sleeping scans belonging to the push targets */
+	void WakePushTargets(const TArray<TScriptInterface<IPusherTarget>>& PushTargets) const;
+
+	/**
+	 * Re-add pushers from the current options that the scan lost, but are still within ContactExitDistance
+	 * The gap is measured from our scaled scan shape, the same shape that found them
+	 */
+	void HoldExitingContacts(const FPushPawnScanContext& Context, TArray<TScriptInterface<IPusherTarget>>& PushTargets) const;
+
+	/**
+	 * @return True if we or any neighbor has moved far enough, or enough time has passed for a pawn outside the list
+	 * to close the skin, that the neighbor list may be missing candidates
+	 */
+	bool ShouldRebuildNeighbors(const FVector& Location) const;
+
+	/**
+	 * Gather every push-capable candidate within the scan range plus NeighborSkin
+	 * The scan range is grown to the largest our speed and acceleration can scale it to, so it can't outgrow the list
+	 */
+	void RebuildNeighbors(const UWorld* World, const FVector& Location, const FQuat& Rotation,
+		const FCollisionShape& Shape, float ShapeScalar, const FCollisionQueryParams& Params);
+
+	/** @return The largest scalar our speed and acceleration can apply to the radius of the scan shape */
+	float GetMaxShapeScalar() const;
+
+	/**
+	 * Find the most deeply penetrating neighbor, no trace is performed
+	 * Neighbors with a pushee shape are tested analytically, others fall back to a physics penetration test
+	 */
+	void QueryNeighbors(FHitResult& OutHitResult, const FVector& Location, const FQuat& Rotation,
+		const FCollisionShape& Shape) const;
 	
+	/** Points into Profile, or OwnedScanParams if we weren't given one */
+	const FPushPawnScanParams* ScanParams = nullptr;
+
+	/** Only allocated when created without a profile */
+	TUniquePtr<FPushPawnScanParams> OwnedScanParams;
+
 	UPROPERTY(Transient, DuplicateTransient)
-	FPushPawnScanParams ScanParams;
+	TObjectPtr<const UPushPawnProfile> Profile;
 
 	UPROPERTY(Transient, DuplicateTransient)
 	FGameplayAbilityTargetingLocationInfo StartLocation;
@@ -72,6 +290,48 @@ private:
 	UPROPERTY(Transient, DuplicateTransient)
 	float CurrentScanRate;
 
+	/** Earliest contact found by the last predictive scan */
+	FHitResult PredictedContact;
+
+	/** Seconds until PredictedContact occurs, -1 if there is no contact ahead of us */
+	float PredictedTimeOfImpact = -1.f;
+
+	/** Interval until the next scan when using time-to-contact scheduling, -1 if not yet computed */
+	float TimeToContactInterval = -1.f;
+
+	/** The last time we moved or had push options */
+	float LastActiveTime = 0.f;
+
+	FTimerHandle SleepTimerHandle;
+
+	bool bSleeping = false;
+
+	/** Paused via IPusheeInstigator::GetPushPawnScanPausedDelegate(), waking from sleep will not resume the scan */
+	bool bScanPausedExternally = false;
+
+	/** Registered with UPushPawnSubsystem */
+	bool bRegistered = false;
+
+	/** Not scanning on authority, the owning client's pushes are verified instead */
+	bool bDeferredToClient = false;
+
+	/** Listening for the owning client's deferral signal while deferred */
+	bool bWaitingForClientSync = false;
+
+	/** World time until which we scan regardless of deferring to the client */
+	float FallbackScanEndTime = -1.f;
+
+	/** Candidates within the scan range plus NeighborSkin */
+	TArray<FPushPawnNeighbor> Neighbors;
+
+	/** Our location when the neighbor list was built */
+	FVector NeighborListLocation = FVector::ZeroVector;
+
+	/** World time when the neighbor list was built */
+	float NeighborListTime = 0.f;
+
+	bool bHasNeighborList = false;
+
 	FTimerHandle TimerHandle;
 
 	FConsoleVariableDelegate OnDisabledDelegate;
@@ -7,6 +7,7 @@
 #include "PushOption.h"
 #include "PushQuery.h"
 #include "IPush.h"
+#include "PushPawnStats.h"
 #include "AbilityTask_PushPawnScan_Base.generated.h"
 
 class UPushPawn_Scan_Base;
@@ -32,12 +33,16 @@ public:
 	/** GameplayAbility that created us */
 	UPROPERTY()
 	TObjectPtr<UPushPawn_Scan_Base> PushScanAbility;
+
+	/** Add the memory held by our containers to Usage, see p.PushPawn.MemReport */
+	virtual void AccumulateMemoryUsage(FPushPawnMemoryUsage& Usage) const;
 	
 protected:
 	ECollisionChannel TraceChannel;
 
 	TArray<FPushOption> CurrentOptions;
 
+	/** Abilities we've granted on first contact, only checked when the ability wasn't found, i.e. it wasn't pre-granted */
 	TMap<FObjectKey, FGameplayAbilitySpecHandle> PushAbilityCache;
 
 protected:
@@ -46,7 +51,19 @@ protected:
 	static void ShapeTrace(FHitResult& OutHitResult, const UWorld* World, const FVector& Center, const FQuat& Rotation,
 		const ECollisionChannel ChannelName, const FCollisionQueryParams& Params, const FCollisionShape& Shape);
 
-	void UpdatePushOptions(const FPushQuery& PushQuery, const TArray<TScriptInterface<IPusherTarget>>& PushTargets);
+	/**
+	 * Sweep the shape from Start to End
+	 * @return The earliest hit along the sweep, including initial overlaps (Time == 0)
+	 */
+	static void ShapeSweep(FHitResult& OutHitResult, const UWorld* World, const FVector& Start, const FVector& End,
+		const FQuat& Rotation, const ECollisionChannel ChannelName, const FCollisionQueryParams& Params, const FCollisionShape& Shape);
+
+	/**
+	 * Gather the push options from each push target, and broadcast PushObjectsChanged if they differ from the current options
+	 * @param LocationTolerance Options whose locations moved less than this are not considered changed
+	 */
+	void UpdatePushOptions(const FPushQuery& PushQuery, const TArray<TScriptInterface<IPusherTarget>>& PushTargets,
+		float LocationTolerance = 0.f);
 
 	virtual void OnDestroy(bool bInOwnerFinished) override;
 };
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "Abilities/GameplayAbilityTypes.h"
 #include "AbilityTask_PushPawnSync.generated.h"
 
 class UAbilityTask_PushPawnSync;
@@ -12,7 +13,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPushPawnNetworkSyncDelegate, UAbili
 /**
  * Task for providing a generic sync point for client server (one can wait for a signal from the other)
  * Identical to UAbilityTask_SyncPushPawn, except the delegate provides the node that broadcasted so it can be removed from a TArray
- * Only performs OnlyServerWait
+ * Only performs OnlyServerWait, on the event passed to WaitNetSync() so separate handshakes don't consume each other's signals
  */
 UCLASS()
 class PUSHPAWN_API UAbilityTask_PushPawnSync : public UAbilityTask
@@ -44,12 +45,16 @@ public:
 	 *	for cleanliness of the graph. The "signal" is "ability instance wide".
 	 *	
 	 */
-	static UAbilityTask_PushPawnSync* WaitNetSync(UGameplayAbility* OwningAbility);
+	static UAbilityTask_PushPawnSync* WaitNetSync(UGameplayAbility* OwningAbility,
+		EAbilityGenericReplicatedEvent::Type SignalEvent = EAbilityGenericReplicatedEvent::GenericSignalFromClient);
 
 protected:
 
 	void SyncFinished();
 
+	/** The event the client signals and the server waits for */
+	EAbilityGenericReplicatedEvent::Type SignalEvent;
+
 	/** The event we replicate */
 	EAbilityGenericReplicatedEvent::Type ReplicatedEventToListenFor;
 };
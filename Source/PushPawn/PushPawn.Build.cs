@@ -15,6 +15,7 @@ public class PushPawn : ModuleRules
 				"GameplayAbilities",
 				"GameplayTasks",
 				"GameplayTags",
+				"DeveloperSettings",
 			}
 			);
 			
@@ -24,7 +25,14 @@ public class PushPawn : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Json",
 			}
 			);
+
+		// PushPawn.Benchmark starts a play session with clients to measure the position error between them
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 	}
 }